@@ -0,0 +1,28 @@
+/* Every module built from this interface wraps the same classes, so all the
+   types are shared between the modules as they are imported. */
+
+%inline %{
+
+class A {
+public:
+    A () {}
+    virtual ~A () {}
+    void func () {}
+};
+
+class B : public A {};
+class C : public B {};
+class D : public C {};
+class E : public D {};
+class F : public E {};
+class G : public F {};
+class H : public G {};
+
+typedef A AA;
+typedef H HH;
+
+void take_a(A *) {}
+void take_h(H *) {}
+A *make_a() { return new H(); }
+
+%}
@@ -0,0 +1,13 @@
+# Time importing all the Simple_N modules built by the Makefile, which share
+# their types, to measure how module loading scales with the number of modules.
+
+import glob
+import sys
+import time
+
+modules = sorted(glob.glob("Simple_*.py"), key=lambda f: int(f[7:-3]))
+t1 = time.time()
+for m in modules:
+    __import__(m[:-3])
+t2 = time.time()
+print("importing %d modules took %f seconds" % (len(modules), t2 - t1))
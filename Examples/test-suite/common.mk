@@ -376,6 +376,7 @@ CPP_TEST_CASES += \
 	rename_pcre_encoder \
 	rename_pcre_enum \
 	rename_predicates \
+	rename_priority \
 	rename_wildcard \
 	restrict_cplusplus \
 	return_const_value \
@@ -531,6 +532,7 @@ CPP_TEST_CASES += \
 	typemap_template_typedef \
 	typemap_out_optimal \
 	typemap_qualifier_strip \
+	typemap_search_cache \
 	typemap_variables \
 	typemap_various \
 	typename \
@@ -744,6 +746,7 @@ MULTI_CPP_TEST_CASES += \
 	multi_import \
 	packageoption \
 	template_typedef_import \
+	type_registry \
 
 # Custom tests - tests with additional commandline options
 wallkw.cpptest: SWIGOPT += -Wallkw
@@ -792,6 +795,10 @@ check-cpp: $(CPP_TEST_CASES:=.cpptest)
 
 check-cpp11: $(CPP11_TEST_CASES:=.cpptest)
 
+# List the testcases run by the check target, as used by Tools/test-suite-timing.py
+check-list:
+	@echo $(NOT_BROKEN_TEST_CASES)
+
 ifdef HAS_DOXYGEN
 check-doxygen: $(DOXYGEN_TEST_CASES:=.cpptest)
 endif
@@ -862,5 +869,5 @@ clean: $(ALL_CLEAN)
 distclean: clean
 	@rm -f Makefile
 
-.PHONY: all check partialcheck broken clean distclean 
+.PHONY: all check check-list partialcheck broken clean distclean 
 
@@ -0,0 +1,137 @@
+using System;
+using csharp_blittableNamespace;
+
+public class runme
+{
+  static void Main()
+  {
+    // Structs passed by value
+    Point p = csharp_blittable.make_point(3.0, 4.0);
+    check(p.x == 3.0 && p.y == 4.0, "make_point");
+    if (p.ToString() != "(3, 4)")
+      throw new Exception("proxycode failed: " + p.ToString());
+
+    Point q = new Point();
+    q.x = 2.0;
+    q.y = 0.5;
+    check(csharp_blittable.dot(p, q) == 8.0, "dot");
+    check(csharp_blittable.add_ints(2, 3) == 5, "add_ints");
+    check(csharp_blittable.point_name() == "Point", "point_name");
+    // SuppressGCTransition is only available in .NET 5 and later
+    if (Type.GetType("System.Runtime.InteropServices.SuppressGCTransitionAttribute") != null) {
+      check(HasSuppressGCTransition("add_ints"), "add_ints SuppressGCTransition");
+      check(!HasSuppressGCTransition("point_name"), "point_name SuppressGCTransition");
+    }
+
+    // Structs passed by reference
+    csharp_blittable.scale(ref q, 2.0);
+    check(q.x == 4.0 && q.y == 1.0, "scale");
+    csharp_blittable.translate(ref q, 1.0, -1.0);
+    check(q.x == 5.0 && q.y == 0.0, "translate");
+
+    Point o = csharp_blittable.origin();
+    check(o.x == 0.0 && o.y == 0.0, "origin");
+
+    try {
+      csharp_blittable.null_point();
+      throw new Exception("null_point did not throw");
+    } catch (NullReferenceException) {
+    }
+
+    // Nested structs and enums
+    Segment s = csharp_blittable.make_segment(csharp_blittable.make_point(1.0, 1.0), csharp_blittable.make_point(4.0, 5.0), 7);
+    check(s.id == 7 && s.start.x == 1.0 && s.end.y == 5.0, "make_segment");
+    check(csharp_blittable.segment_length_squared(s) == 25.0, "segment_length_squared");
+
+    Pixel dark = new Pixel();
+    dark.r = 10;
+    dark.dominant = Channel.Red;
+    Pixel light = new Pixel();
+    light.r = 200;
+    light.g = 200;
+    light.b = 200;
+    light.dominant = Channel.Blue;
+    Pixel bright = csharp_blittable.brightest(dark, light);
+    check(bright.r == 200 && bright.dominant == Channel.Blue, "brightest");
+
+    // Non-public data members are kept in the layout
+    Sample sample = csharp_blittable.make_sample(21);
+    check(sample.value == 21, "make_sample");
+    check(csharp_blittable.sample_twice(sample) == 42, "sample_twice");
+
+    // Arrays of structs
+    Point[] points = new Point[3];
+    csharp_blittable.fill_points(points, points.Length);
+    check(points[2].x == 2.0 && points[2].y == -2.0, "fill_points");
+    check(csharp_blittable.sum_x(points, points.Length) == 3.0, "sum_x");
+    csharp_blittable.swap_coordinates(points, points.Length);
+    check(points[1].x == -1.0 && points[1].y == 1.0, "swap_coordinates");
+
+    // Member variables
+    Shape shape = new Shape();
+    shape.centre = p;
+    check(shape.centre.x == 3.0 && shape.centre.y == 4.0, "Shape.centre");
+
+    // Directors
+    PointTransform transform = new Mirror();
+    Point mirrored = transform.call_apply(1.0, 2.0);
+    check(mirrored.x == -1.0 && mirrored.y == -2.0, "Mirror.apply");
+
+    // Bulk copies of vectors
+    PointVector pv = new PointVector(points);
+    check(pv.Count == 3, "PointVector count");
+    check(csharp_blittable.sum_y(pv) == 3.0, "sum_y");
+    pv.AddRange(new PointVector(new Point[] { p }));
+    Point[] copy = pv.ToArray();
+    check(copy.Length == 4 && copy[3].x == 3.0 && copy[1].y == 1.0, "PointVector.ToArray");
+    Point[] partial = new Point[5];
+    pv.CopyTo(2, partial, 1, 2);
+    check(partial[1].x == -2.0 && partial[2].y == 4.0 && partial[3].x == 0.0, "PointVector.CopyTo");
+    check(pv[3].x == 3.0, "PointVector indexer");
+
+    IntVector iv = new IntVector(new int[] { 1, 2, 3 });
+    iv.AddRange(new IntVector(new int[] { 4, 5 }));
+    iv.AddRange(new IntVector(new int[0]));
+    int[] ints = iv.ToArray();
+    check(ints.Length == 5 && ints[0] == 1 && ints[4] == 5, "IntVector.ToArray");
+    check(new IntVector().ToArray().Length == 0, "empty IntVector.ToArray");
+
+    DoubleVector dv = new DoubleVector(new double[] { 1.5, 2.5 });
+    double[] doubles = new double[4];
+    dv.CopyTo(doubles, 2);
+    check(doubles[2] == 1.5 && doubles[3] == 2.5, "DoubleVector.CopyTo");
+    try {
+      dv.CopyTo(doubles, 3);
+      throw new Exception("CopyTo did not throw");
+    } catch (ArgumentException) {
+    }
+  }
+
+  class Mirror : PointTransform
+  {
+    public override Point apply(Point p)
+    {
+      Point m = new Point();
+      m.x = -p.x;
+      m.y = -p.y;
+      return m;
+    }
+  }
+
+  static bool HasSuppressGCTransition(string name)
+  {
+    Type pinvoke = typeof(csharp_blittable).Assembly.GetType("csharp_blittableNamespace.csharp_blittablePINVOKE");
+    System.Reflection.MethodInfo method = pinvoke.GetMethod(name, System.Reflection.BindingFlags.Static | System.Reflection.BindingFlags.Public | System.Reflection.BindingFlags.NonPublic);
+    foreach (object attribute in method.GetCustomAttributes(false)) {
+      if (attribute.GetType().Name == "SuppressGCTransitionAttribute")
+        return true;
+    }
+    return false;
+  }
+
+  static void check(bool ok, string what)
+  {
+    if (!ok)
+      throw new Exception(what + " failed");
+  }
+}
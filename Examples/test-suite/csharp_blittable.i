@@ -0,0 +1,176 @@
+%module(directors="1") csharp_blittable
+
+%include <std_vector.i>
+
+%csharp_blittable(Point)
+%csharp_blittable(Pixel)
+%csharp_blittable(Segment)
+%csharp_blittable(Sample)
+
+%apply Point INPUT[] { Point *input_points }
+%apply Point OUTPUT[] { Point *output_points }
+%apply Point INOUT[] { Point *inout_points }
+
+%ignore Sample::twice;
+%ignore Sample::init;
+
+%feature("director") PointTransform;
+
+// Quick functions that do not call back into managed code
+%cssuppressgctransition dot;
+%cssuppressgctransition add_ints;
+%warnfilter(SWIGWARN_CSHARP_SUPPRESSGCTRANSITION) point_name;
+%cssuppressgctransition point_name;
+
+%extend Point {
+%proxycode %{
+  public override string ToString() {
+    return "(" + x + ", " + y + ")";
+  }
+%}
+}
+
+%inline %{
+enum Channel { Red, Green, Blue };
+
+struct Point {
+  double x;
+  double y;
+};
+
+struct Pixel {
+  unsigned char r, g, b, a;
+  Channel dominant;
+};
+
+struct Segment {
+  Point start;
+  Point end;
+  int id;
+};
+
+class Sample {
+public:
+  int value;
+  int twice() const { return 2 * hidden; }
+  void init(int v) { value = v; hidden = v; }
+private:
+  short hidden;
+};
+
+Point make_point(double x, double y) {
+  Point p;
+  p.x = x;
+  p.y = y;
+  return p;
+}
+
+double dot(const Point &a, const Point &b) {
+  return a.x * b.x + a.y * b.y;
+}
+
+void scale(Point &p, double factor) {
+  p.x *= factor;
+  p.y *= factor;
+}
+
+void translate(Point *p, double dx, double dy) {
+  p->x += dx;
+  p->y += dy;
+}
+
+Point &origin() {
+  static Point origin_point = { 0.0, 0.0 };
+  return origin_point;
+}
+
+Point *null_point() {
+  return 0;
+}
+
+Segment make_segment(const Point &start, const Point &end, int id) {
+  Segment s;
+  s.start = start;
+  s.end = end;
+  s.id = id;
+  return s;
+}
+
+double segment_length_squared(Segment s) {
+  double dx = s.end.x - s.start.x;
+  double dy = s.end.y - s.start.y;
+  return dx * dx + dy * dy;
+}
+
+Pixel brightest(Pixel a, Pixel b) {
+  return (a.r + a.g + a.b >= b.r + b.g + b.b) ? a : b;
+}
+
+Sample make_sample(int v) {
+  Sample s;
+  s.init(v);
+  return s;
+}
+
+int sample_twice(const Sample &s) {
+  return s.twice();
+}
+
+double sum_x(Point *input_points, int n) {
+  double sum = 0;
+  for (int i = 0; i < n; ++i)
+    sum += input_points[i].x;
+  return sum;
+}
+
+void fill_points(Point *output_points, int n) {
+  for (int i = 0; i < n; ++i) {
+    output_points[i].x = i;
+    output_points[i].y = -i;
+  }
+}
+
+void swap_coordinates(Point *inout_points, int n) {
+  for (int i = 0; i < n; ++i) {
+    double tmp = inout_points[i].x;
+    inout_points[i].x = inout_points[i].y;
+    inout_points[i].y = tmp;
+  }
+}
+
+struct Shape {
+  Point centre;
+  int sides;
+};
+
+class PointTransform {
+public:
+  virtual ~PointTransform() {}
+  virtual Point apply(const Point &p) { return p; }
+  Point call_apply(double x, double y) { return apply(make_point(x, y)); }
+};
+%}
+
+SWIG_STD_VECTOR_BLITTABLE(Point)
+%template(PointVector) std::vector<Point>;
+%template(IntVector) std::vector<int>;
+%template(DoubleVector) std::vector<double>;
+
+%inline %{
+double sum_y(const std::vector<Point> &points) {
+  double sum = 0;
+  for (size_t i = 0; i < points.size(); ++i)
+    sum += points[i].y;
+  return sum;
+}
+%}
+
+%inline %{
+int add_ints(int a, int b) {
+  return a + b;
+}
+
+const char *point_name() {
+  return "Point";
+}
+%}
@@ -0,0 +1,20 @@
+%module cpp_csharp_suppressgctransition
+
+// The SuppressGCTransition attribute cannot be used when the wrapper can call back into managed code
+%cssuppressgctransition;
+
+%inline %{
+struct Thing {};
+int quick(int i) { return i; }
+const char *name() { return "name"; }
+void by_reference(Thing &t) {}
+%}
+
+%exception might_throw %{
+  if (0) SWIG_exception(SWIG_RuntimeError, "error");
+  $action
+%}
+
+%inline %{
+void might_throw() {}
+%}
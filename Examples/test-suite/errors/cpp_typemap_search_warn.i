@@ -0,0 +1,11 @@
+%module xxx
+
+// Warnings issued while searching for typemaps must be repeated for each
+// declaration using the type, the search results are not to be cached
+
+template<typename T> struct Wrapper {};
+
+using nowhere::Thing;
+
+void take1(Wrapper<Thing> *w);
+void take2(Wrapper<Thing> *w);
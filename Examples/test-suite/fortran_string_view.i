@@ -0,0 +1,23 @@
+%module fortran_string_view
+
+// The (const char *STRING, size_t LENGTH) typemap passes the Fortran characters
+// to the function without copying them
+%include <std_string.i>
+
+%apply (const char *STRING, size_t LENGTH) { (const char *str, size_t len) }
+
+%inline %{
+#include <string>
+
+const void *view_address(const char *str, size_t len) {
+  return str;
+}
+
+size_t view_length(const char *str, size_t len) {
+  return len;
+}
+
+std::string view_copy(const char *str, size_t len) {
+  return std::string(str, len);
+}
+%}
@@ -0,0 +1,45 @@
+%module fortran_thread_local_error
+
+// Give each thread its own error code and message
+#define SWIG_FORTRAN_THREAD_LOCAL_ERROR
+%include <std_except.i>
+
+%exception {
+  SWIG_check_unhandled_exception();
+  try {
+    $action
+  } catch (const std::exception& e) {
+    SWIG_exception(SWIG_RuntimeError, e.what());
+  }
+}
+
+%{
+#include <stdexcept>
+#include <thread>
+%}
+
+%inline %{
+int checked_sqrt(int value) {
+  if (value < 0)
+    throw std::domain_error("negative value");
+  int result = 0;
+  while ((result + 1) * (result + 1) <= value)
+    ++result;
+  return result;
+}
+%}
+
+%{
+// Store an error in another thread: it must not be seen by the caller
+int error_in_other_thread() {
+  int other_code = 0;
+  std::thread t([&other_code]() {
+    SWIG_store_exception("error_in_other_thread", SWIG_RuntimeError, "other thread");
+    other_code = ierr();
+  });
+  t.join();
+  return other_code;
+}
+%}
+
+int error_in_other_thread();
@@ -0,0 +1,22 @@
+%module fortran_thread_local_error_c
+
+// Use a small error buffer to check long messages are truncated
+%begin %{
+#define SWIG_FORTRAN_ERROR_BUFFER_SIZE 40
+%}
+
+// Give each thread its own error code and message
+#define SWIG_FORTRAN_THREAD_LOCAL_ERROR
+%include <exception.i>
+
+%inline %{
+int checked_negate(int value) {
+  if (value < 0)
+    SWIG_store_exception("checked_negate", SWIG_ValueError, "negative value");
+  return -value;
+}
+
+void long_error(void) {
+  SWIG_store_exception("long_error", SWIG_RuntimeError, "a message too long for the error buffer");
+}
+%}
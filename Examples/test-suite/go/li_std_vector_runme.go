@@ -0,0 +1,76 @@
+package main
+
+import . "swigtests/li_std_vector"
+
+func main() {
+	iv := NewIntVector()
+	iv.AddSlice([]int{1, 2, 3, 4})
+	iv.Add(5)
+	if iv.Size() != 5 || iv.Get(3) != 4 {
+		panic("AddSlice failed")
+	}
+
+	s := make([]int, iv.Size())
+	if iv.GetSlice(0, s) != 5 || s[0] != 1 || s[4] != 5 {
+		panic(s)
+	}
+
+	// Only the elements that fit are copied, as with the copy builtin
+	s = make([]int, 10)
+	if iv.GetSlice(3, s) != 2 || s[0] != 4 || s[1] != 5 || s[2] != 0 {
+		panic(s)
+	}
+	if iv.SetSlice(3, []int{40, 50, 60}) != 2 || iv.Get(3) != 40 || iv.Get(4) != 50 || iv.Size() != 5 {
+		panic("SetSlice failed")
+	}
+	if iv.GetSlice(5, s) != 0 {
+		panic("GetSlice at end failed")
+	}
+
+	func() {
+		defer func() {
+			if recover() == nil {
+				panic("GetSlice out of range did not panic")
+			}
+		}()
+		iv.GetSlice(6, s)
+	}()
+
+	dv := NewDoubleVector()
+	dv.AddSlice([]float64{0.5, 1.5})
+	d := make([]float64, 2)
+	dv.GetSlice(0, d)
+	if d[0] != 0.5 || d[1] != 1.5 {
+		panic(d)
+	}
+
+	bv := NewBoolVector()
+	bv.AddSlice([]bool{true, false, true})
+	b := make([]bool, 3)
+	bv.GetSlice(0, b)
+	if !b[0] || b[1] || !b[2] {
+		panic(b)
+	}
+
+	cv := NewCharVector()
+	cv.AddSlice([]byte("swig"))
+	c := make([]byte, cv.Size())
+	cv.GetSlice(0, c)
+	if string(c) != "swig" {
+		panic(string(c))
+	}
+
+	lv := NewLongVector()
+	lv.AddSlice([]int64{-1, 1 << 30})
+	l := make([]int64, 2)
+	lv.GetSlice(0, l)
+	if l[0] != -1 || l[1] != 1<<30 {
+		panic(l)
+	}
+
+	rv := NewRealVector()
+	rv.AddSlice([]float32{2.5})
+	if rv.Get(0) != 2.5 {
+		panic("RealVector failed")
+	}
+}
@@ -179,5 +179,41 @@ public class li_std_vector_runme {
     checkThat(arrayInit.size() == 5);
     checkThat(arrayInit.get(0) == 1);
     checkThat(arrayInit.get(4) == 5);
+
+    // Bulk transfer of primitive arrays
+    DoubleVector dv = new DoubleVector(new double[]{1.5, 2.5, 3.5});
+    checkThat(dv.size() == 3);
+    checkThat(dv.get(2) == 3.5);
+    checkThat(java.util.Arrays.equals(dv.toPrimitiveArray(), new double[]{1.5, 2.5, 3.5}));
+    checkThat(dv.addAll(new double[]{4.5, 5.5}));
+    checkThat(!dv.addAll(new double[0]));
+    checkThat(dv.size() == 5);
+    checkThat(dv.get(4) == 5.5);
+    dv.fromArray(new double[]{9});
+    checkThat(dv.size() == 1);
+    checkThat(dv.get(0) == 9);
+    dv.fromArray(new double[0]);
+    checkThat(dv.isEmpty());
+    checkThat(dv.toPrimitiveArray().length == 0);
+    try {
+      dv.fromArray(null);
+      checkThat(false);
+    } catch (NullPointerException e) {
+    }
+
+    // Direct buffer aliasing the vector's storage
+    dv.fromArray(new double[]{1, 2, 3});
+    java.nio.DoubleBuffer buffer = dv.asDirectBuffer();
+    checkThat(buffer.capacity() == 3);
+    checkThat(buffer.get(1) == 2);
+    buffer.put(1, 20);
+    checkThat(dv.get(1) == 20);
+    dv.set(2, 30.0);
+    checkThat(buffer.get(2) == 30);
+
+    IntVector iv = new IntVector();
+    iv.fromArray(new int[]{7, 8, 9});
+    checkThat(java.util.Arrays.equals(iv.toPrimitiveArray(), new int[]{7, 8, 9}));
+    checkThat(iv.asDirectBuffer().get(0) == 7);
   }
 }
@@ -0,0 +1,6 @@
+/* Copied to importcache_imported.h and imported by importcache.i */
+#ifdef IMPORTCACHE_LONG
+typedef long importcache_int;
+#else
+typedef short importcache_int;
+#endif
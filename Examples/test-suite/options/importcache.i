@@ -0,0 +1,8 @@
+%module importcache
+
+// Tests -importcache, see importcache.sh
+%import "importcache_imported.h"
+
+%inline %{
+importcache_int importcache_get() { return 0; }
+%}
@@ -0,0 +1,43 @@
+# The -importcache option caches the preprocessed %import files. Run SWIG
+# several times on a copy of the input files, checking the cache is written
+# and reused and that changing the imported file or the macros defined on the
+# command line or corrupting the cache file are all handled. The imported
+# header is copied under a different name so that the original is not found
+# in the current directory instead.
+
+cp ${SRCDIR}importcache.i $WORKDIR
+cp ${SRCDIR}importcache.h $WORKDIR/importcache_imported.h
+mkdir $WORKDIR/cache
+
+run_swig() {
+  $SWIG -c++ -python -Wall -importcache $WORKDIR/cache -I$WORKDIR -outdir $WORKDIR -o $WORKDIR/importcache_wrap.cxx "$@" $WORKDIR/importcache.i
+  grep -o 'SWIG_From_[a-z]*(static_cast< [a-z]* >(result))' $WORKDIR/importcache_wrap.cxx
+  echo "cache entries: `ls $WORKDIR/cache | wc -l | tr -d ' '`"
+}
+
+echo "cold run"
+run_swig
+cp $WORKDIR/importcache_wrap.cxx $WORKDIR/cold_wrap.cxx
+
+echo "warm run"
+run_swig
+cmp $WORKDIR/cold_wrap.cxx $WORKDIR/importcache_wrap.cxx && echo "same output"
+
+echo "warm run using a modified cache entry"
+for f in $WORKDIR/cache/*; do
+  sed -e 's/typedef short importcache_int/typedef float importcache_int/' $f > $f.tmp && mv $f.tmp $f
+done
+run_swig
+
+echo "truncated cache entry"
+for f in $WORKDIR/cache/*; do
+  head -c 40 $f > $f.tmp && mv $f.tmp $f
+done
+run_swig
+
+echo "-D option"
+run_swig -DIMPORTCACHE_LONG
+
+echo "modified imported file"
+sed -e 's/short/int/' ${SRCDIR}importcache.h > $WORKDIR/importcache_imported.h
+run_swig
@@ -0,0 +1,9 @@
+%module profile
+
+// Tests -profile, see profile.sh
+%inline %{
+struct ProfileClass {
+  int method(int i) { return i; }
+};
+int profile_function(const char *s) { return 0; }
+%}
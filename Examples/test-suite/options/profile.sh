@@ -0,0 +1,22 @@
+# The -profile option displays a timing report. Check the text and JSON
+# reports list the processing phases and the language handlers used and that
+# the generated code is the same as without -profile. The times vary, so only
+# the names are compared.
+
+run_swig() {
+  $SWIG -c++ -python -Wall -outdir $WORKDIR -o $WORKDIR/profile_wrap.cxx "$@" ${SRCDIR}profile.i
+}
+
+run_swig
+mv $WORKDIR/profile_wrap.cxx $WORKDIR/noprofile_wrap.cxx
+
+echo "text report"
+run_swig -profile > $WORKDIR/profile.txt
+cmp $WORKDIR/noprofile_wrap.cxx $WORKDIR/profile_wrap.cxx && echo "same output"
+sed -n -e 's/^\(phase:[a-z]*\) .*/\1/p' -e 's/^\(handler:[A-Za-z]*\) .*/\1/p' $WORKDIR/profile.txt | LC_ALL=C sort
+
+echo "JSON report"
+run_swig -profile=json > $WORKDIR/profile.json
+cmp $WORKDIR/noprofile_wrap.cxx $WORKDIR/profile_wrap.cxx && echo "same output"
+grep -o '"[a-z]*": \[' $WORKDIR/profile.json
+sed -n -e 's/.*"name": "\(phase:[a-z]*\)".*/\1/p' -e 's/.*"name": "\(handler:[A-Za-z]*\)".*/\1/p' $WORKDIR/profile.json | LC_ALL=C sort
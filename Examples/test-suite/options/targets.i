@@ -0,0 +1,9 @@
+%module targets
+
+// Tests -targets, see targets.sh
+%inline %{
+struct TargetsClass {
+  int method(int i) { return i; }
+};
+int targets_function(const char *s) { return 0; }
+%}
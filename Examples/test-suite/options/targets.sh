@@ -0,0 +1,13 @@
+# The -targets option generates the wrappers for several target languages.
+# Check the files for each language are put in a subdirectory named after the
+# language and are the same as when running SWIG separately for each language.
+
+mkdir $WORKDIR/separate $WORKDIR/separate/python $WORKDIR/separate/java
+
+$SWIG -c++ -Wall -targets python,java -o $WORKDIR/targets_wrap.cxx ${SRCDIR}targets.i
+find $WORKDIR -type f | LC_ALL=C sort
+
+$SWIG -c++ -Wall -python -o $WORKDIR/separate/python/targets_wrap.cxx ${SRCDIR}targets.i
+$SWIG -c++ -Wall -java -o $WORKDIR/separate/java/targets_wrap.cxx ${SRCDIR}targets.i
+diff -r $WORKDIR/separate/python $WORKDIR/python && echo "python: same output"
+diff -r $WORKDIR/separate/java $WORKDIR/java && echo "java: same output"
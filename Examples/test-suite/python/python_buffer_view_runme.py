@@ -0,0 +1,153 @@
+import array
+import gc
+import sys
+from python_buffer_view import *
+
+def check(flag):
+    if not flag:
+        raise RuntimeError("Test failed")
+
+# Views share the memory of the vector
+v = make_doubles(4)
+check(isinstance(v, DoubleVector))
+m = v.buffer_view()
+check(m.format == "d" and m.itemsize == 8 and m.shape == (4,) and not m.readonly)
+check(m.tolist() == [0.0, 0.5, 1.0, 1.5])
+m[1] = 10.0
+check(v[1] == 10.0)
+v[2] = 20.0
+check(m[2] == 20.0)
+
+# The view keeps the vector alive
+del v
+gc.collect()
+check(m.tolist() == [0.0, 10.0, 20.0, 1.5])
+m.release()
+
+# Methods changing the size of the vector fail while it is viewed, as for bytearray
+v = DoubleVector([1.0, 2.0, 3.0])
+m = v.buffer_view()
+w = DoubleVector([4.0])
+resizers = [
+    lambda: v.append(4.0),
+    lambda: v.push_back(4.0),
+    lambda: v.pop(),
+    lambda: v.pop_back(),
+    lambda: v.resize(10),
+    lambda: v.resize(10, 1.0),
+    lambda: v.reserve(100),
+    lambda: v.clear(),
+    lambda: v.insert(v.begin(), 4.0),
+    lambda: v.erase(v.begin()),
+    lambda: v.assign(10, 1.0),
+    lambda: v.__delitem__(0),
+    lambda: v.__delitem__(slice(0, 1)),
+    lambda: v.__setitem__(slice(0, 1), DoubleVector([1.0, 2.0])),
+    lambda: v.swap(w),
+    lambda: w.swap(v),
+]
+for resize in resizers:
+    try:
+        resize()
+        raise RuntimeError("vector resized while viewed")
+    except BufferError:
+        pass
+check(m.tolist() == [1.0, 2.0, 3.0] and len(v) == 3 and len(w) == 1)
+m2 = v.buffer_view()
+m.release()
+try:
+    v.append(4.0)
+    raise RuntimeError("vector resized while viewed")
+except BufferError:
+    pass
+m2.release()
+# The vector can be resized again once all the views are released
+for resize in resizers:
+    resize()
+m = w.buffer_view()
+del m
+v.swap(w)
+
+# The methods changing the size still use the global %exception
+n = action_count()
+v.append(1.0)
+check(action_count() == n + 2)
+m = v.buffer_view()
+try:
+    v.append(1.0)
+    raise RuntimeError("vector resized while viewed")
+except BufferError:
+    pass
+m.release()
+
+check(len(DoubleVector().buffer_view()) == 0)
+check(IntVector([1, 2, 3]).buffer_view().format == "i")
+
+# The vector itself supports the buffer protocol with -builtin and from Python 3.12
+v = DoubleVector([1.0, 2.0])
+if sys.version_info[0:2] >= (3, 12) or not hasattr(v, "__buffer__"):
+    m = memoryview(v)
+    check(m.tolist() == [1.0, 2.0])
+    m[0] = 3.0
+    check(v[0] == 3.0)
+    try:
+        v.append(4.0)
+        raise RuntimeError("vector resized while viewed")
+    except BufferError:
+        pass
+    m.release()
+    v.append(4.0)
+
+# Buffers are copied into vectors passed by value or reference
+check(sum_doubles(array.array("d", [1.0, 2.0, 3.5])) == 6.5)
+check(sum_doubles(memoryview(array.array("d", [1.0, 2.0]))) == 3.0)
+check(count_ints(array.array("i", [1, 2, 3, 4])) == 4)
+check(count_ints(array.array("i")) == 0)
+# Buffers of other types are converted item by item as before
+check(count_ints(array.array("h", [1, 2])) == 2)
+check(sum_doubles([1.0, 2.0]) == 3.0)
+check(sum_doubles(DoubleVector([1.0, 4.0])) == 5.0)
+
+# Arrays are viewed in the same way, and never change their size
+a = make_array(1)
+check(isinstance(a, IntArray3))
+m = a.buffer_view()
+check(m.format == "i" and m.shape == (3,) and m.tolist() == [1, 2, 3])
+m[0] = 5
+check(a[0] == 5)
+a[1] = 6
+a[0:3] = [7, 8, 9]
+check(m.tolist() == [7, 8, 9])
+b = make_array(0)
+a.swap(b)
+check(m.tolist() == [0, 1, 2] and list(b) == [7, 8, 9])
+m.release()
+check(sum_array(array.array("i", [1, 2, 3])) == 6)
+check(sum_array([1, 2, 4]) == 7)
+
+# Pointer and size pairs work on the memory of the buffer
+a = array.array("d", [1.0, 2.0, 3.0])
+scale(a, 2.0)
+check(a.tolist() == [2.0, 4.0, 6.0])
+v = DoubleVector([1.0, 2.0])
+scale(v.buffer_view(), 3.0)
+check(list(v) == [3.0, 6.0])
+check(sum_ints(array.array("i", [1, 2, 3])) == 6)
+
+try:
+    scale(array.array("f", [1.0]), 2.0)
+    raise RuntimeError("float array accepted for double *")
+except TypeError:
+    pass
+
+try:
+    sum_ints(bytes(array.array("i", [4, 5])))
+    raise RuntimeError("bytes accepted for int *")
+except TypeError:
+    pass
+
+try:
+    scale(bytes(array.array("d", [1.0])), 2.0)
+    raise RuntimeError("read-only buffer accepted for double *")
+except TypeError:
+    pass
@@ -0,0 +1,63 @@
+from python_dirvtable import *
+
+def check(got, expected):
+    if got != expected:
+        raise RuntimeError("got %r, expected %r" % (got, expected))
+
+class Inherits(Hook):
+    def pure(self, i):
+        return -i
+
+class Overrides(Inherits):
+    def value(self, i):
+        return 10 * i
+
+# Methods not overridden in Python call the C++ method
+a = Inherits()
+b = Inherits()
+check(call_value(a, 2), 2)
+check(call_value(b, 3), 3)
+check(call_name(a), "Hook")
+check(call_pure(a, 4), -4)
+
+# The GIL is released when calling the C++ method directly
+if is_python_dirvtable():
+    check(call_gil_held(a), False)
+
+c = Overrides()
+check(call_value(c, 2), 20)
+check(call_name(c), "Hook")
+
+# Modifying a class is seen by all its instances and those of derived classes
+if not is_python_builtin():
+    Inherits.value = lambda self, i: 100 * i
+    check(call_value(a, 2), 200)
+    check(call_value(b, 3), 300)
+    check(call_value(c, 2), 20)
+    del Inherits.value
+    check(call_value(a, 2), 2)
+
+    Inherits.name = lambda self: "Inherits"
+    check(call_name(a), "Inherits")
+    check(call_name(c), "Inherits")
+
+# Attributes of an instance hide the methods of its class
+b.value = lambda i: -i
+check(call_value(b, 3), -3)
+check(call_value(a, 3), 3)
+del b.value
+check(call_value(b, 3), 3)
+
+# Classes created and deleted in turn, possibly at the same address, do not
+# share their cached methods
+for i in range(20):
+    if i % 2:
+        class Temporary(Inherits):
+            def value(self, j, i=i):
+                return i * j
+        check(call_value(Temporary(), 3), 3 * i)
+    else:
+        class Temporary(Inherits):
+            pass
+        check(call_value(Temporary(), 3), 3)
+    del Temporary
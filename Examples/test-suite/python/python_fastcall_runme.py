@@ -0,0 +1,74 @@
+from python_fastcall import *
+
+
+def check(got, expected):
+    if got != expected:
+        raise RuntimeError("got %s, expected %s" % (got, expected))
+
+
+def check_type_error(func, *args, **kwargs):
+    try:
+        func(*args, **kwargs)
+    except TypeError:
+        return
+    raise RuntimeError("TypeError not raised")
+
+check(sum2(1, 2), 3)
+check(sum3(1, 2), 103)
+check(sum3(1, 2, 3), 6)
+check_type_error(sum2, 1)
+check_type_error(sum3, 1, 2, 3, 4)
+
+check(kwsum(1), 111)
+check(kwsum(1, 2), 103)
+check(kwsum(1, c=3), 14)
+check(kwsum(c=3, a=1, b=2), 6)
+check(kwsum(**{"a": 1, "b": 2}), 103)
+check_type_error(kwsum)
+check_type_error(kwsum, b=2)
+check_type_error(kwsum, 1, a=2)
+check_type_error(kwsum, 1, d=2)
+
+c = Calc(1000)
+check(c.base, 1000)
+c.base = 2000
+check(c.base, 2000)
+c.base = 1000
+check(c.add(1, 2), 1003)
+check_type_error(c.add, 1)
+check(c.kwscale(3), 1006)
+check(c.kwscale(3, factor=3), 1009)
+check(c.kwscale(factor=4, a=1), 1004)
+check(Calc.twice(1), 4)
+check(Calc.twice(1, 2), 6)
+check(Calc.kwoffset(1), 6)
+check(Calc.kwoffset(1, offset=2), 3)
+check_type_error(Calc.kwoffset, offset=2)
+
+check(Counter().count, 0)
+check_type_error(Counter, 1)
+
+p = Point(1, 2)
+check((p.x, p.y), (1, 2))
+p = Point(3)
+check((p.x, p.y), (3, 0))
+p = Point(y=4, x=5)
+check((p.x, p.y), (5, 4))
+check_type_error(Point)
+check_type_error(Point, 1, x=2)
+
+
+class DerivedPoint(Point):
+    def __init__(self, x):
+        Point.__init__(self, x, y=2 * x)
+        self.name = "derived"
+
+p = DerivedPoint(6)
+check((p.x, p.y, p.name), (6, 12, "derived"))
+
+
+class PlainPoint(Point):
+    pass
+
+p = PlainPoint(7, y=8)
+check((type(p), p.x, p.y), (PlainPoint, 7, 8))
@@ -0,0 +1,14 @@
+from rename_priority import *
+
+if PRIO_A() != 1:
+    raise RuntimeError("PRIO_A")
+if named_prio_b() != 2:
+    raise RuntimeError("named_prio_b")
+if PRIO_C() != 3:
+    raise RuntimeError("PRIO_C")
+if second_prio_e() != 5:
+    raise RuntimeError("second_prio_e")
+if full_prio_f() != 6:
+    raise RuntimeError("full_prio_f")
+if Klass().PRIO_METHOD() != 7:
+    raise RuntimeError("Klass.PRIO_METHOD")
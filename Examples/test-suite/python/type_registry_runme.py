@@ -0,0 +1,22 @@
+import type_registry_a
+import type_registry_b
+
+def check(query, name, expected):
+    found = query(name)
+    if found != expected:
+        raise RuntimeError("query for {} found '{}', expected '{}'".format(name, found, expected))
+
+for query in type_registry_a.type_registry_a_query, type_registry_b.type_registry_b_query:
+    # Mangled names
+    check(query, "_p_Shared", "_p_Shared")
+    check(query, "_p_OnlyA", "_p_OnlyA")
+    check(query, "_p_OnlyB", "_p_OnlyB")
+    # Human readable names, including the typedefs of either module
+    check(query, "Shared *", "_p_Shared")
+    check(query, "Shared*", "_p_Shared")
+    check(query, "SharedAlias *", "_p_Shared")
+    check(query, "OnlyA *", "_p_OnlyA")
+    check(query, "OnlyB *", "_p_OnlyB")
+    # Unknown types
+    check(query, "_p_Unknown", "")
+    check(query, "Unknown *", "")
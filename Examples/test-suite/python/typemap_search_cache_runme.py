@@ -0,0 +1,22 @@
+from typemap_search_cache import *
+
+if before() != 10:
+    raise RuntimeError("before failed")
+
+if redefined() != 20:
+    raise RuntimeError("redefined failed")
+
+if cleared(5) != 5:
+    raise RuntimeError("cleared failed")
+
+if typedef_before(5) != 5:
+    raise RuntimeError("typedef_before failed")
+
+if typedef_after() != 30:
+    raise RuntimeError("typedef_after failed")
+
+if applied_before(5) != 5:
+    raise RuntimeError("applied_before failed")
+
+if applied_after() != 30:
+    raise RuntimeError("applied_after failed")
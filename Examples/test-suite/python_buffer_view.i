@@ -0,0 +1,73 @@
+%module python_buffer_view
+
+%include <pybuffer.i>
+%include <std_vector.i>
+%include <std_array.i>
+
+%{
+static int action_calls = 0;
+%}
+
+/* A global %exception, which must still apply to the methods changing the size */
+%exception {
+  ++action_calls;
+  $action
+}
+
+%python_buffer_view(std::vector<double>)
+%python_buffer_view(std::vector<int>)
+%template(DoubleVector) std::vector<double>;
+%template(IntVector) std::vector<int>;
+%python_buffer_view(std::array<int, 3>)
+%template(IntArray3) std::array<int, 3>;
+
+%python_buffer_array(double *data, size_t n);
+%python_buffer_array(const int *data, size_t n);
+
+%inline %{
+#include <vector>
+#include <array>
+
+int action_count() {
+  return action_calls;
+}
+
+std::vector<double> make_doubles(int n) {
+  std::vector<double> v;
+  for (int i = 0; i < n; ++i)
+    v.push_back(i * 0.5);
+  return v;
+}
+
+double sum_doubles(const std::vector<double> &v) {
+  double sum = 0;
+  for (size_t i = 0; i < v.size(); ++i)
+    sum += v[i];
+  return sum;
+}
+
+size_t count_ints(std::vector<int> v) {
+  return v.size();
+}
+
+std::array<int, 3> make_array(int first) {
+  std::array<int, 3> a = {{first, first + 1, first + 2}};
+  return a;
+}
+
+int sum_array(const std::array<int, 3> &a) {
+  return a[0] + a[1] + a[2];
+}
+
+void scale(double *data, size_t n, double factor) {
+  for (size_t i = 0; i < n; ++i)
+    data[i] *= factor;
+}
+
+int sum_ints(const int *data, size_t n) {
+  int sum = 0;
+  for (size_t i = 0; i < n; ++i)
+    sum += data[i];
+  return sum;
+}
+%}
@@ -0,0 +1,41 @@
+%module(directors="1", threads="1") python_dirvtable
+
+%include <std_string.i>
+
+%feature("director") Hook;
+
+%inline %{
+#include <string>
+
+class Hook {
+public:
+  virtual ~Hook() {}
+  virtual int value(int i) { return i; }
+  virtual std::string name() const { return "Hook"; }
+  virtual int pure(int i) = 0;
+  virtual bool gil_held() const {
+#if PY_VERSION_HEX >= 0x03040000
+    return PyGILState_Check() != 0;
+#else
+    return false;
+#endif
+  }
+};
+
+int call_value(Hook *h, int i) { return h->value(i); }
+std::string call_name(Hook *h) { return h->name(); }
+int call_pure(Hook *h, int i) { return h->pure(i); }
+bool call_gil_held(Hook *h) { return h->gil_held(); }
+
+#ifdef SWIG_PYTHON_DIRECTOR_VTABLE
+bool is_python_dirvtable() { return true; }
+#else
+bool is_python_dirvtable() { return false; }
+#endif
+
+#ifdef SWIGPYTHON_BUILTIN
+bool is_python_builtin() { return true; }
+#else
+bool is_python_builtin() { return false; }
+#endif
+%}
@@ -0,0 +1,34 @@
+/* Test the wrappers called with a vector of arguments generated with the -fastcall option */
+
+%module python_fastcall
+
+%feature("kwargs") kwsum;
+%feature("kwargs") Calc::kwscale;
+%feature("kwargs") Calc::kwoffset;
+%feature("kwargs") Point::Point;
+
+%inline %{
+int sum2(int a, int b) { return a + b; }
+int sum3(int a, int b, int c = 100) { return a + b + c; }
+int kwsum(int a, int b = 10, int c = 100) { return a + b + c; }
+
+struct Calc {
+  int base;
+  Calc(int base) : base(base) {}
+  int add(int a, int b) const { return base + a + b; }
+  int kwscale(int a, int factor = 2) const { return base + a * factor; }
+  static int twice(int a, int b = 1) { return 2 * (a + b); }
+  static int kwoffset(int a, int offset = 5) { return a + offset; }
+};
+
+struct Counter {
+  int count;
+  Counter() : count(0) {}
+};
+
+struct Point {
+  int x;
+  int y;
+  Point(int x, int y = 0) : x(x), y(y) {}
+};
+%}
@@ -0,0 +1,24 @@
+%module rename_priority
+
+// Test that overlapping %rename rules are applied newest first when some of the
+// rules name the declaration they apply to and others apply to all declarations
+%rename("%(strip:[prio_])s") "";
+%rename("named_%s", %$isfunction) prio_a;
+%rename("%(upper)s", %$isfunction) "";
+%rename("named_%s", %$isfunction) prio_b;
+%rename("first_%s", %$isfunction) prio_e;
+%rename("second_%s", %$isfunction) prio_e;
+%rename("full_prio_f", fullname=1, %$isfunction) "PrioSpace::prio_f";
+
+%inline %{
+int prio_a() { return 1; }
+int prio_b() { return 2; }
+int prio_c() { return 3; }
+int prio_e() { return 5; }
+namespace PrioSpace {
+  int prio_f() { return 6; }
+}
+struct prio_Klass {
+  int prio_method() { return 7; }
+};
+%}
@@ -115,3 +115,23 @@ end
 
 
 
+
+# test_compaction
+# Tracked objects must still be found after GC compaction has moved them
+if GC.respond_to?(:verify_compaction_references)
+  foo15 = bar.get_owned_foo()
+  begin
+    begin
+      GC.verify_compaction_references(toward: :empty, expand_heap: true)
+    rescue ArgumentError
+      GC.verify_compaction_references(toward: :empty, double_heap: true)
+    end
+  rescue NotImplementedError
+  end
+
+  test_same_ruby_object(foo15, bar.get_owned_foo())
+
+  if not (bar.get_owned_foo().say_hello == "Hello")
+    raise "Invalid C++ object returned after compaction."
+  end
+end
@@ -0,0 +1,10 @@
+struct Shared {
+  int value;
+};
+typedef Shared SharedAlias;
+
+struct OnlyA {
+  int value;
+};
+
+inline void take_shared_alias(SharedAlias *) {}
@@ -0,0 +1,18 @@
+/* Part of a test of the lookup of types by SWIG_TypeQueryModule when several
+   modules share the types, see type_registry_b.i. */
+
+%module type_registry_a
+
+%{
+#include "type_registry_a.h"
+%}
+
+%include "type_registry_a.h"
+
+%inline %{
+/* Return the mangled name of the type found when looking up name in all the modules */
+const char *type_registry_a_query(const char *name) {
+  swig_type_info *ty = SWIG_TypeQueryModule(&swig_module, &swig_module, name);
+  return ty ? ty->name : "";
+}
+%}
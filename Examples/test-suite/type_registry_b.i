@@ -0,0 +1,24 @@
+/* Part of a test of the lookup of types by SWIG_TypeQueryModule when several
+   modules share the types, see type_registry_a.i. */
+
+%module type_registry_b
+
+%import "type_registry_a.i"
+
+%{
+#include "type_registry_a.h"
+%}
+
+%inline %{
+struct OnlyB {
+  int value;
+};
+
+void take_shared(Shared *) {}
+
+/* Return the mangled name of the type found when looking up name in all the modules */
+const char *type_registry_b_query(const char *name) {
+  swig_type_info *ty = SWIG_TypeQueryModule(&swig_module, &swig_module, name);
+  return ty ? ty->name : "";
+}
+%}
@@ -0,0 +1,34 @@
+%module typemap_search_cache
+
+// Typemap searches are cached, check the cache is not stale after the typemaps change
+
+%typemap(default) int val "$1 = 10;"
+%inline %{
+int before(int val) { return val; }
+%}
+
+%typemap(default) int val "$1 = 20;"
+%inline %{
+int redefined(int val) { return val; }
+%}
+
+%clear int val;
+%inline %{
+int cleared(int val) { return val; }
+%}
+
+%inline %{
+typedef int Integer;
+int typedef_before(Integer ival) { return ival; }
+%}
+
+%typemap(default) int ival "$1 = 30;"
+%inline %{
+int typedef_after(Integer ival) { return ival; }
+int applied_before(int aval) { return aval; }
+%}
+
+%apply int ival { int aval };
+%inline %{
+int applied_after(int aval) { return aval; }
+%}
@@ -13,12 +13,118 @@
  *
  *   SWIG_STD_VECTOR_ENHANCED(SomeNamespace::Klass)
  *   %template(VectKlass) std::vector<SomeNamespace::Klass>;
+ *
+ * When T is a primitive type with the same size in C# and C++ or a struct wrapped
+ * with %csharp_blittable, the elements are copied to and from C# arrays in bulk by
+ * the array constructor, CopyTo and ToArray methods. Use the
+ * SWIG_STD_VECTOR_BLITTABLE macro for blittable structs, for example:
+ *
+ *   %csharp_blittable(Point)
+ *   SWIG_STD_VECTOR_BLITTABLE(Point)
+ *   %template(VectPoint) std::vector<Point>;
+ *
+ * The AddSpan and CopyToSpan methods, which take a ReadOnlySpan<T> and Span<T>,
+ * are also generated when SWIG_CSHARP_SPAN is defined, which requires .NET Core
+ * 2.1 or later.
  * ----------------------------------------------------------------------------- */
 
 %include <std_common.i>
 
 // MACRO for use within the std::vector class body
 %define SWIG_STD_VECTOR_MINIMUM_INTERNAL(CSINTERFACE, CONST_REFERENCE, CTYPE...)
+%proxycode %{
+  public void CopyTo(int index, $typemap(cstype, CTYPE)[] array, int arrayIndex, int count)
+  {
+    if (array == null)
+      throw new global::System.ArgumentNullException("array");
+    if (index < 0)
+      throw new global::System.ArgumentOutOfRangeException("index", "Value is less than zero");
+    if (arrayIndex < 0)
+      throw new global::System.ArgumentOutOfRangeException("arrayIndex", "Value is less than zero");
+    if (count < 0)
+      throw new global::System.ArgumentOutOfRangeException("count", "Value is less than zero");
+    if (array.Rank > 1)
+      throw new global::System.ArgumentException("Multi dimensional array.", "array");
+    if (index+count > this.Count || arrayIndex+count > array.Length)
+      throw new global::System.ArgumentException("Number of elements to copy is too large.");
+    for (int i=0; i<count; i++)
+      array.SetValue(getitemcopy(index+i), arrayIndex+i);
+  }
+
+  public $typemap(cstype, CTYPE)[] ToArray() {
+    $typemap(cstype, CTYPE)[] array = new $typemap(cstype, CTYPE)[this.Count];
+    this.CopyTo(array);
+    return array;
+  }
+%}
+SWIG_STD_VECTOR_COMMON_INTERNAL(CSINTERFACE, CONST_REFERENCE, CTYPE)
+%enddef
+
+// MACRO for use within the std::vector class body for blittable types, the elements
+// are copied between the vector and pinned C# arrays in a single call
+%define SWIG_STD_VECTOR_BLITTABLE_INTERNAL(CSINTERFACE, CONST_REFERENCE, CTYPE...)
+%proxycode %{
+  public $csclassname($typemap(cstype, CTYPE)[] values) : this() {
+    if (values == null)
+      throw new global::System.ArgumentNullException("values");
+    if (values.Length > 0)
+      additems(ref values[0], values.Length);
+  }
+
+  public void CopyTo(int index, $typemap(cstype, CTYPE)[] array, int arrayIndex, int count)
+  {
+    if (array == null)
+      throw new global::System.ArgumentNullException("array");
+    if (index < 0)
+      throw new global::System.ArgumentOutOfRangeException("index", "Value is less than zero");
+    if (arrayIndex < 0)
+      throw new global::System.ArgumentOutOfRangeException("arrayIndex", "Value is less than zero");
+    if (count < 0)
+      throw new global::System.ArgumentOutOfRangeException("count", "Value is less than zero");
+    if (index+count > this.Count || arrayIndex+count > array.Length)
+      throw new global::System.ArgumentException("Number of elements to copy is too large.");
+    if (count > 0)
+      getitems(index, ref array[arrayIndex], count);
+  }
+
+  public $typemap(cstype, CTYPE)[] ToArray() {
+    $typemap(cstype, CTYPE)[] array = new $typemap(cstype, CTYPE)[this.Count];
+    this.CopyTo(array);
+    return array;
+  }
+%}
+#if defined(SWIG_CSHARP_SPAN)
+%proxycode %{
+  public void AddSpan(global::System.ReadOnlySpan<$typemap(cstype, CTYPE)> values) {
+    if (values.Length > 0)
+      additems(ref global::System.Runtime.InteropServices.MemoryMarshal.GetReference(values), values.Length);
+  }
+
+  public void CopyToSpan(int index, global::System.Span<$typemap(cstype, CTYPE)> span) {
+    if (index < 0)
+      throw new global::System.ArgumentOutOfRangeException("index", "Value is less than zero");
+    int count = this.Count - index;
+    if (count < 0 || count > span.Length)
+      throw new global::System.ArgumentException("Number of elements to copy is too large.");
+    if (count > 0)
+      getitems(index, ref global::System.Runtime.InteropServices.MemoryMarshal.GetReference(span), count);
+  }
+%}
+#endif
+SWIG_STD_VECTOR_COMMON_INTERNAL(CSINTERFACE, CONST_REFERENCE, CTYPE)
+    %extend {
+      // Range checked by the C# caller
+      void getitems(int index, CTYPE *SWIG_STD_VECTOR_ITEMS, int count) {
+        std::copy($self->begin() + index, $self->begin() + index + count, SWIG_STD_VECTOR_ITEMS);
+      }
+      void additems(const CTYPE *SWIG_STD_VECTOR_ITEMS, int count) {
+        $self->insert($self->end(), SWIG_STD_VECTOR_ITEMS, SWIG_STD_VECTOR_ITEMS + count);
+      }
+    }
+%enddef
+
+// Elements used by both the element by element and blittable std::vector class bodies
+%define SWIG_STD_VECTOR_COMMON_INTERNAL(CSINTERFACE, CONST_REFERENCE, CTYPE...)
 %typemap(csinterfaces) std::vector< CTYPE > "global::System.IDisposable, global::System.Collections.IEnumerable, global::System.Collections.Generic.CSINTERFACE<$typemap(cstype, CTYPE)>\n";
 %proxycode %{
   public $csclassname(global::System.Collections.IEnumerable c) : this() {
@@ -91,30 +197,6 @@
     CopyTo(0, array, arrayIndex, this.Count);
   }
 
-  public void CopyTo(int index, $typemap(cstype, CTYPE)[] array, int arrayIndex, int count)
-  {
-    if (array == null)
-      throw new global::System.ArgumentNullException("array");
-    if (index < 0)
-      throw new global::System.ArgumentOutOfRangeException("index", "Value is less than zero");
-    if (arrayIndex < 0)
-      throw new global::System.ArgumentOutOfRangeException("arrayIndex", "Value is less than zero");
-    if (count < 0)
-      throw new global::System.ArgumentOutOfRangeException("count", "Value is less than zero");
-    if (array.Rank > 1)
-      throw new global::System.ArgumentException("Multi dimensional array.", "array");
-    if (index+count > this.Count || arrayIndex+count > array.Length)
-      throw new global::System.ArgumentException("Number of elements to copy is too large.");
-    for (int i=0; i<count; i++)
-      array.SetValue(getitemcopy(index+i), arrayIndex+i);
-  }
-
-  public $typemap(cstype, CTYPE)[] ToArray() {
-    $typemap(cstype, CTYPE)[] array = new $typemap(cstype, CTYPE)[this.Count];
-    this.CopyTo(array);
-    return array;
-  }
-
   global::System.Collections.Generic.IEnumerator<$typemap(cstype, CTYPE)> global::System.Collections.Generic.IEnumerable<$typemap(cstype, CTYPE)>.GetEnumerator() {
     return new $csclassnameEnumerator(this);
   }
@@ -357,6 +439,36 @@ namespace std {
 }
 %enddef
 
+// Typemaps for passing a reference to the first element of a pinned C# array or span
+%define SWIG_STD_VECTOR_BLITTABLE_TYPEMAPS(CTYPE...)
+%typemap(ctype) CTYPE *SWIG_STD_VECTOR_ITEMS, const CTYPE *SWIG_STD_VECTOR_ITEMS "CTYPE *"
+%typemap(imtype) CTYPE *SWIG_STD_VECTOR_ITEMS, const CTYPE *SWIG_STD_VECTOR_ITEMS "ref $typemap(cstype, CTYPE)"
+%typemap(cstype) CTYPE *SWIG_STD_VECTOR_ITEMS, const CTYPE *SWIG_STD_VECTOR_ITEMS "ref $typemap(cstype, CTYPE)"
+%typemap(csin) CTYPE *SWIG_STD_VECTOR_ITEMS, const CTYPE *SWIG_STD_VECTOR_ITEMS "ref $csinput"
+%typemap(in) CTYPE *SWIG_STD_VECTOR_ITEMS, const CTYPE *SWIG_STD_VECTOR_ITEMS "$1 = $input;"
+%enddef
+
+// Blittable structs wrapped by %csharp_blittable, which do not need operator==
+%define SWIG_STD_VECTOR_BLITTABLE(CTYPE...)
+SWIG_STD_VECTOR_BLITTABLE_TYPEMAPS(CTYPE)
+namespace std {
+  template<> class vector< CTYPE > {
+    SWIG_STD_VECTOR_BLITTABLE_INTERNAL(IEnumerable, const value_type&, %arg(CTYPE))
+  };
+}
+%enddef
+
+// Primitive types with the same size in C# and C++
+%define SWIG_STD_VECTOR_ENHANCED_BLITTABLE(CTYPE...)
+SWIG_STD_VECTOR_BLITTABLE_TYPEMAPS(CTYPE)
+namespace std {
+  template<> class vector< CTYPE > {
+    SWIG_STD_VECTOR_BLITTABLE_INTERNAL(IList, const value_type&, %arg(CTYPE))
+    SWIG_STD_VECTOR_EXTRA_OP_EQUALS_EQUALS(CTYPE)
+  };
+}
+%enddef
+
 // Legacy macros
 %define SWIG_STD_VECTOR_SPECIALIZE(CSTYPE, CTYPE...)
 #warning SWIG_STD_VECTOR_SPECIALIZE macro deprecated, please see csharp/std_vector.i and switch to SWIG_STD_VECTOR_ENHANCED
@@ -379,6 +491,8 @@ SWIG_STD_VECTOR_ENHANCED(CTYPE)
 %csmethodmodifiers std::vector::size "private"
 %csmethodmodifiers std::vector::capacity "private"
 %csmethodmodifiers std::vector::reserve "private"
+%csmethodmodifiers std::vector::getitems "private"
+%csmethodmodifiers std::vector::additems "private"
 
 namespace std {
   // primary (unspecialized) class template for std::vector
@@ -400,19 +514,20 @@ namespace std {
 
 // template specializations for std::vector
 // these provide extra collections methods as operator== is defined
+// long is not blittable as it is not the same size as the C# int it is mapped to on all platforms
 SWIG_STD_VECTOR_ENHANCED(char)
-SWIG_STD_VECTOR_ENHANCED(signed char)
-SWIG_STD_VECTOR_ENHANCED(unsigned char)
-SWIG_STD_VECTOR_ENHANCED(short)
-SWIG_STD_VECTOR_ENHANCED(unsigned short)
-SWIG_STD_VECTOR_ENHANCED(int)
-SWIG_STD_VECTOR_ENHANCED(unsigned int)
+SWIG_STD_VECTOR_ENHANCED_BLITTABLE(signed char)
+SWIG_STD_VECTOR_ENHANCED_BLITTABLE(unsigned char)
+SWIG_STD_VECTOR_ENHANCED_BLITTABLE(short)
+SWIG_STD_VECTOR_ENHANCED_BLITTABLE(unsigned short)
+SWIG_STD_VECTOR_ENHANCED_BLITTABLE(int)
+SWIG_STD_VECTOR_ENHANCED_BLITTABLE(unsigned int)
 SWIG_STD_VECTOR_ENHANCED(long)
 SWIG_STD_VECTOR_ENHANCED(unsigned long)
-SWIG_STD_VECTOR_ENHANCED(long long)
-SWIG_STD_VECTOR_ENHANCED(unsigned long long)
-SWIG_STD_VECTOR_ENHANCED(float)
-SWIG_STD_VECTOR_ENHANCED(double)
+SWIG_STD_VECTOR_ENHANCED_BLITTABLE(long long)
+SWIG_STD_VECTOR_ENHANCED_BLITTABLE(unsigned long long)
+SWIG_STD_VECTOR_ENHANCED_BLITTABLE(float)
+SWIG_STD_VECTOR_ENHANCED_BLITTABLE(double)
 SWIG_STD_VECTOR_ENHANCED(std::string) // also requires a %include <std_string.i>
 SWIG_STD_VECTOR_ENHANCED(std::wstring) // also requires a %include <std_wstring.i>
 
@@ -21,6 +21,101 @@
 #define SWIG_FORTRAN_ERROR_INT ierr
 #endif
 
+#ifdef SWIG_FORTRAN_THREAD_LOCAL_ERROR
+
+/* -------------------------------------------------------------------------
+ * Thread-local error state
+ *
+ * Defining SWIG_FORTRAN_THREAD_LOCAL_ERROR gives each thread its own error
+ * code and message, so that wrapped functions can be called from OpenMP
+ * parallel regions. A thread-local variable can't be bound to Fortran, so
+ * the error code is read with the function `ierr()` and set with the
+ * subroutine `set_ierr(value)`, both bound directly to C functions.
+ * ------------------------------------------------------------------------- */
+#ifndef SWIG_FORTRAN_ERROR_SET
+#define SWIG_FORTRAN_ERROR_SET set_ierr
+#endif
+
+#define SWIG_FORTRAN_ERROR_CODE swig_fortran_error_code
+
+%fragment("SWIG_fortran_thread_local", "runtime") %{
+#ifndef SWIG_FORTRAN_THREAD_LOCAL
+# if defined(__cplusplus) && __cplusplus >= 201103L
+#  define SWIG_FORTRAN_THREAD_LOCAL thread_local
+# elif !defined(__cplusplus) && defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#  define SWIG_FORTRAN_THREAD_LOCAL _Thread_local
+# elif defined(_MSC_VER)
+#  define SWIG_FORTRAN_THREAD_LOCAL __declspec(thread)
+# else
+#  define SWIG_FORTRAN_THREAD_LOCAL __thread
+# endif
+#endif
+
+#ifndef SWIG_FORTRAN_ERROR_BUFFER_SIZE
+# define SWIG_FORTRAN_ERROR_BUFFER_SIZE 1024
+#endif
+%}
+
+%fragment("SWIG_fortran_thread_local");
+%fragment("<string.h>");
+
+%insert("header") {
+SWIGINTERN SWIG_FORTRAN_THREAD_LOCAL int swig_fortran_error_code = 0;
+SWIGINTERN SWIG_FORTRAN_THREAD_LOCAL char swig_fortran_error_buffer[SWIG_FORTRAN_ERROR_BUFFER_SIZE];
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+SWIGEXPORT int SWIG_FORTRAN_ERROR_INT(void) {
+  return swig_fortran_error_code;
+}
+
+SWIGEXPORT void SWIG_FORTRAN_ERROR_SET(int value) {
+  swig_fortran_error_code = value;
+}
+#ifdef __cplusplus
+}
+#endif
+
+/* Append str at position pos of the error message of the current thread,
+ * truncating it to the size of the buffer, and return the new position */
+SWIGINTERN size_t SWIG_fortran_append_error(size_t pos, const char *str) {
+  size_t len = strlen(str);
+  if (len > SWIG_FORTRAN_ERROR_BUFFER_SIZE - 1 - pos)
+    len = SWIG_FORTRAN_ERROR_BUFFER_SIZE - 1 - pos;
+  memcpy(swig_fortran_error_buffer + pos, str, len);
+  return pos + len;
+}
+
+/* Format an error message in the fixed buffer of the current thread, so that
+ * nothing needs to be freed when the thread exits */
+SWIGINTERN const char *SWIG_fortran_format_error(const char *decl, const char *msg, const char *suffix) {
+  size_t pos = SWIG_fortran_append_error(0, "In ");
+  pos = SWIG_fortran_append_error(pos, decl);
+  pos = SWIG_fortran_append_error(pos, ": ");
+  pos = SWIG_fortran_append_error(pos, msg);
+  pos = SWIG_fortran_append_error(pos, suffix);
+  swig_fortran_error_buffer[pos] = '\0';
+  return swig_fortran_error_buffer;
+}
+}
+
+/* Declare C-bound accessors, available from Fortran */
+%fortranbindc SWIG_FORTRAN_ERROR_INT;
+%fortranbindc SWIG_FORTRAN_ERROR_SET;
+#ifdef __cplusplus
+extern "C" {
+#endif
+int SWIG_FORTRAN_ERROR_INT(void);
+void SWIG_FORTRAN_ERROR_SET(int value);
+#ifdef __cplusplus
+}
+#endif
+
+#else
+
+#define SWIG_FORTRAN_ERROR_CODE SWIG_FORTRAN_ERROR_INT
+
 /* Declare C-bound global, available from Fortran */
 %fortranbindc SWIG_FORTRAN_ERROR_INT;
 %inline {
@@ -33,6 +128,8 @@ int SWIG_FORTRAN_ERROR_INT = 0;
 #endif
 }
 
+#endif /* SWIG_FORTRAN_THREAD_LOCAL_ERROR */
+
 /* -------------------------------------------------------------------------
  * Error string retrieval
  *
@@ -90,7 +187,11 @@ SWIGEXPORT void SWIG_store_exception(const char* decl, int errcode, const char *
  * ------------------------------------------------------------------------- */
 %insert("header") {
 // Stored exception message
+#ifdef SWIG_FORTRAN_THREAD_LOCAL_ERROR
+SWIGINTERN SWIG_FORTRAN_THREAD_LOCAL const char* swig_last_exception_cstr = NULL;
+#else
 SWIGINTERN const char* swig_last_exception_cstr = NULL;
+#endif
 // Retrieve error message
 SWIGEXPORT const char* SWIG_FORTRAN_ERROR_STR() {
   if (!swig_last_exception_cstr) {
@@ -111,7 +212,7 @@ SWIGEXPORT const char* SWIG_FORTRAN_ERROR_STR() {
 extern "C" {
 // Call this function before any new action
 SWIGEXPORT void SWIG_check_unhandled_exception_impl(const char* decl) {
-  if (SWIG_FORTRAN_ERROR_INT != 0) {
+  if (SWIG_FORTRAN_ERROR_CODE != 0) {
     // Construct message; calling the error string function ensures that
     // the string is allocated if the user did something goofy like
     // manually setting the integer. Since this function is not expected to
@@ -131,8 +232,11 @@ SWIGEXPORT void SWIG_check_unhandled_exception_impl(const char* decl) {
 SWIGEXPORT void SWIG_store_exception(const char *decl,
                                      int errcode,
                                      const char *msg) {
-  ::SWIG_FORTRAN_ERROR_INT = errcode;
+  ::SWIG_FORTRAN_ERROR_CODE = errcode;
 
+#ifdef SWIG_FORTRAN_THREAD_LOCAL_ERROR
+  swig_last_exception_cstr = SWIG_fortran_format_error(decl, msg, "");
+#else
   static std::string last_exception_msg;
   // Save the message to a std::string first
   last_exception_msg = "In ";
@@ -140,6 +244,7 @@ SWIGEXPORT void SWIG_store_exception(const char *decl,
   last_exception_msg += ": ";
   last_exception_msg += msg;
   swig_last_exception_cstr = last_exception_msg.c_str();
+#endif
 }
 }
 }
@@ -152,20 +257,24 @@ SWIGEXPORT void SWIG_store_exception(const char *decl,
 
 %insert("header") {
 SWIGEXPORT void SWIG_check_unhandled_exception_impl(const char* decl) {
-  if (SWIG_FORTRAN_ERROR_INT != 0) {
+  if (SWIG_FORTRAN_ERROR_CODE != 0) {
     printf("An unhandled error %d occurred before a call to %s\n",
-           SWIG_FORTRAN_ERROR_INT, decl);
-    exit(SWIG_FORTRAN_ERROR_INT);
+           SWIG_FORTRAN_ERROR_CODE, decl);
+    exit(SWIG_FORTRAN_ERROR_CODE);
   }
 }
 
 SWIGEXPORT void SWIG_store_exception(const char *decl,
                                      int errcode,
                                      const char *msg) {
+#ifdef SWIG_FORTRAN_THREAD_LOCAL_ERROR
+  swig_last_exception_cstr = SWIG_fortran_format_error(decl, msg, "\n");
+#else
   static char exception_buffer[1024];
   sprintf(exception_buffer, "In %s: %s\n", decl, msg);
-  SWIG_FORTRAN_ERROR_INT = errcode;
   swig_last_exception_cstr = exception_buffer;
+#endif
+  SWIG_FORTRAN_ERROR_CODE = errcode;
 }
 }
 #endif /* __cplusplus */
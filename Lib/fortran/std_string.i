@@ -54,8 +54,11 @@ class string;
 %typemap(imtype) std::string = char*;
 %typemap(ftype) std::string = char*;
 
-// Fortran proxy translation code: convert from char array to Fortran string
-%typemap(fin) std::string = char*;
+// Fortran proxy translation code: the string is copied on the C++ side, so
+// pass the Fortran characters directly
+%typemap(fin, fragment="SWIG_finview"{char*}, noblock=1) std::string {
+  call %fortrantm(finview, char*)($input, $1)
+}
 
 // Fortran proxy translation code: convert from char array to Fortran string
 %typemap(fout, noblock=1,
@@ -72,7 +75,7 @@ class string;
 
 // Construct a temporary string from the Fortran character array
 %typemap(in, noblock=1) const std::string & (std::string tempstr) {
-  tempstr = std::string(static_cast<char *>($input->data), $input->size);
+  tempstr.assign(static_cast<char *>($input->data), $input->size);
   $1 = &tempstr;
 }
 
@@ -11,10 +11,16 @@
  * Additionally, native Fortran integers are used by default for sizes and
  * indexes.
  *
+ * Vectors of numeric types also have a `view` method that returns a Fortran
+ * array pointer to the vector's data without copying, and an `assign` method
+ * that replaces the vector's contents with a Fortran array in a single copy.
+ * The view is invalidated by any call that reallocates the vector.
+ *
  * See the documentation for more details.
  * ------------------------------------------------------------------------- */
 
 %include "std_common.i"
+%include <fortranarray.swg>
 
 %{
 #include <vector>
@@ -126,6 +132,43 @@
   }
 %enddef
 
+%define %swig_std_vector_extend_pod(CTYPE)
+  // Return a Fortran array pointer to the vector's data
+  %fortran_array_pointer(CTYPE, std::vector<CTYPE >& view)
+  %typemap(out, noblock=1) std::vector<CTYPE >& view {
+    $result.data = ($1->empty() ? NULL : &(*$1->begin()));
+    $result.size = $1->size();
+  }
+
+  // Replace the vector's contents with a Fortran array
+  %fortran_array_pointer(CTYPE, %arg((const CTYPE *DATA, size_type SIZE)))
+  %typemap(ftype, in={$typemap(imtype, CTYPE), dimension(:), intent(in), target}, noblock=1) (const CTYPE *DATA, size_type SIZE) {
+    $typemap(imtype, CTYPE), dimension(:), pointer
+  }
+  %typemap(in, noblock=1) (const CTYPE *DATA, size_type SIZE) {
+    $1 = static_cast<$1_ltype>($input->data);
+    $2 = $input->size;
+  }
+
+  %extend {
+    std::vector<CTYPE >& view() {
+      return *$self;
+    }
+
+    void assign(const CTYPE *DATA, size_type SIZE) {
+      $self->assign(DATA, DATA + SIZE);
+    }
+  }
+%enddef
+
+%define %std_vector_pod(CTYPE)
+  template<> class vector<CTYPE > {
+    %swig_std_vector(CTYPE, const CTYPE&)
+    %swig_std_vector_extend_ref(CTYPE)
+    %swig_std_vector_extend_pod(CTYPE)
+  };
+%enddef
+
 namespace std {
   template<class T> class vector {
     %swig_std_vector(T, const T&)
@@ -136,5 +179,19 @@ namespace std {
   template<> class vector<bool> {
     %swig_std_vector(bool, bool)
   };
+
+  // Numeric specializations with array views
+  %std_vector_pod(signed char)
+  %std_vector_pod(short)
+  %std_vector_pod(int)
+  %std_vector_pod(long)
+  %std_vector_pod(long long)
+  %std_vector_pod(unsigned char)
+  %std_vector_pod(unsigned short)
+  %std_vector_pod(unsigned int)
+  %std_vector_pod(unsigned long)
+  %std_vector_pod(unsigned long long)
+  %std_vector_pod(float)
+  %std_vector_pod(double)
 } // end namespace std
 
@@ -1,23 +1,30 @@
 /* -----------------------------------------------------------------------------
  * std_vector.i
+ *
+ * Vectors of the primitive types also have GetSlice, SetSlice and AddSlice
+ * methods, which copy elements to or from a Go slice in a single call rather
+ * than one call per element.  Like the Go copy builtin, GetSlice and SetSlice
+ * copy as many elements as fit and return the number of elements copied:
+ *
+ *   s := make([]float64, v.Size())
+ *   v.GetSlice(0, s)
  * ----------------------------------------------------------------------------- */
 
 %{
 #include <vector>
 #include <stdexcept>
+#include <algorithm>
 %}
 
-namespace std {
-    
-    template<class T> class vector {
+%define SWIG_STD_VECTOR_MINIMUM_INTERNAL(CTYPE, CONST_REFERENCE)
       public:
         typedef size_t size_type;
         typedef ptrdiff_t difference_type;
-        typedef T value_type;
+        typedef CTYPE value_type;
         typedef value_type* pointer;
         typedef const value_type* const_pointer;
         typedef value_type& reference;
-        typedef const value_type& const_reference;
+        typedef CONST_REFERENCE const_reference;
 
         vector();
         vector(size_type n);
@@ -47,46 +54,88 @@ namespace std {
                     throw std::out_of_range("vector index out of range");
             }
         }
-    };
-
-    // bool specialization
-    template<> class vector<bool> {
-      public:
-        typedef size_t size_type;
-        typedef ptrdiff_t difference_type;
-        typedef bool value_type;
-        typedef value_type* pointer;
-        typedef const value_type* const_pointer;
-        typedef value_type& reference;
-        typedef bool const_reference;
+%enddef
 
-        vector();
-        vector(size_type n);
-        vector(const vector& other);
+// A Go slice passed as a pointer to its elements and its length.  GOCTYPE
+// is the C type with the same layout as the Go element type GOTYPE.
+%define SWIG_STD_VECTOR_SLICE_TYPEMAPS(GOCTYPE, GOTYPE)
+%typemap(gotype) (GOCTYPE *SWIG_GO_SLICE, size_t SWIG_GO_SLICE_LEN) "[]GOTYPE"
+%typemap(in) (GOCTYPE *SWIG_GO_SLICE, size_t SWIG_GO_SLICE_LEN)
+%{
+  $1 = ($1_ltype)$input.array;
+  $2 = ($2_ltype)$input.len;
+%}
+%enddef
 
-        size_type size() const;
-        size_type capacity() const;
-        void reserve(size_type n);
-        %rename(isEmpty) empty;
-        bool empty() const;
-        void clear();
-        %rename(add) push_back;
-        void push_back(const value_type& x);
+%define SWIG_STD_VECTOR_SLICE_INTERNAL(CTYPE, GOCTYPE)
         %extend {
-            bool get(int i) throw (std::out_of_range) {
+            int getSlice(int start, GOCTYPE *SWIG_GO_SLICE, size_t SWIG_GO_SLICE_LEN) throw (std::out_of_range) {
                 int size = int(self->size());
-                if (i>=0 && i<size)
-                    return (*self)[i];
-                else
+                if (start<0 || start>size)
                     throw std::out_of_range("vector index out of range");
+                size_t n = std::min(SWIG_GO_SLICE_LEN, size_t(size - start));
+                std::copy(self->begin() + start, self->begin() + start + n, SWIG_GO_SLICE);
+                return int(n);
             }
-            void set(int i, const value_type& val) throw (std::out_of_range) {
+            int setSlice(int start, GOCTYPE *SWIG_GO_SLICE, size_t SWIG_GO_SLICE_LEN) throw (std::out_of_range) {
                 int size = int(self->size());
-                if (i>=0 && i<size)
-                    (*self)[i] = val;
-                else
+                if (start<0 || start>size)
                     throw std::out_of_range("vector index out of range");
+                size_t n = std::min(SWIG_GO_SLICE_LEN, size_t(size - start));
+                std::copy(SWIG_GO_SLICE, SWIG_GO_SLICE + n, self->begin() + start);
+                return int(n);
+            }
+            void addSlice(GOCTYPE *SWIG_GO_SLICE, size_t SWIG_GO_SLICE_LEN) {
+                self->insert(self->end(), SWIG_GO_SLICE, SWIG_GO_SLICE + SWIG_GO_SLICE_LEN);
             }
         }
+%enddef
+
+%define SWIG_STD_VECTOR_SLICE(CTYPE, GOCTYPE)
+namespace std {
+    template<> class vector<CTYPE> {
+        SWIG_STD_VECTOR_MINIMUM_INTERNAL(CTYPE, const value_type&)
+        SWIG_STD_VECTOR_SLICE_INTERNAL(CTYPE, GOCTYPE)
     };
 }
+%enddef
+
+SWIG_STD_VECTOR_SLICE_TYPEMAPS(bool, bool)
+SWIG_STD_VECTOR_SLICE_TYPEMAPS(signed char, int8)
+SWIG_STD_VECTOR_SLICE_TYPEMAPS(unsigned char, byte)
+SWIG_STD_VECTOR_SLICE_TYPEMAPS(short, int16)
+SWIG_STD_VECTOR_SLICE_TYPEMAPS(unsigned short, uint16)
+SWIG_STD_VECTOR_SLICE_TYPEMAPS(intgo, int)
+SWIG_STD_VECTOR_SLICE_TYPEMAPS(uintgo, uint)
+SWIG_STD_VECTOR_SLICE_TYPEMAPS(long long, int64)
+SWIG_STD_VECTOR_SLICE_TYPEMAPS(unsigned long long, uint64)
+SWIG_STD_VECTOR_SLICE_TYPEMAPS(float, float32)
+SWIG_STD_VECTOR_SLICE_TYPEMAPS(double, float64)
+
+namespace std {
+
+    template<class T> class vector {
+        SWIG_STD_VECTOR_MINIMUM_INTERNAL(T, const value_type&)
+    };
+
+    // bool specialization
+    template<> class vector<bool> {
+        SWIG_STD_VECTOR_MINIMUM_INTERNAL(bool, bool)
+        SWIG_STD_VECTOR_SLICE_INTERNAL(bool, bool)
+    };
+}
+
+// Go has no char type, a char is a byte
+SWIG_STD_VECTOR_SLICE(char, unsigned char)
+SWIG_STD_VECTOR_SLICE(signed char, signed char)
+SWIG_STD_VECTOR_SLICE(unsigned char, unsigned char)
+SWIG_STD_VECTOR_SLICE(short, short)
+SWIG_STD_VECTOR_SLICE(unsigned short, unsigned short)
+SWIG_STD_VECTOR_SLICE(int, intgo)
+SWIG_STD_VECTOR_SLICE(unsigned int, uintgo)
+SWIG_STD_VECTOR_SLICE(long, long long)
+SWIG_STD_VECTOR_SLICE(unsigned long, unsigned long long)
+SWIG_STD_VECTOR_SLICE(long long, long long)
+SWIG_STD_VECTOR_SLICE(unsigned long long, unsigned long long)
+SWIG_STD_VECTOR_SLICE(float, float)
+SWIG_STD_VECTOR_SLICE(double, double)
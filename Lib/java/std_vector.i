@@ -5,6 +5,13 @@
  * The Java proxy class extends java.util.AbstractList and implements
  * java.util.RandomAccess. The std::vector container looks and feels much like a
  * java.util.ArrayList from Java.
+ *
+ * Vectors of the primitive types with the same layout as a Java primitive type
+ * (signed char, short, int, long long, float and double) also have bulk
+ * methods, toPrimitiveArray(), fromArray() and addAll(), which copy all the
+ * elements in a single JNI call. Defining SWIG_JAVA_VECTOR_DIRECT_BUFFER adds
+ * asDirectBuffer(), which returns a java.nio buffer aliasing the vector's
+ * storage; it is only valid until the vector is resized or destroyed.
  * ----------------------------------------------------------------------------- */
 
 %include <std_common.i>
@@ -24,8 +31,6 @@ SWIGINTERN jint SWIG_VectorSize(size_t size) {
 }
 
 %define SWIG_STD_VECTOR_MINIMUM_INTERNAL(CTYPE, CONST_REFERENCE)
-%typemap(javabase) std::vector< CTYPE > "java.util.AbstractList<$typemap(jboxtype, CTYPE)>"
-%typemap(javainterfaces) std::vector< CTYPE > "java.util.RandomAccess"
 %proxycode %{
   public $javaclassname($typemap(jstype, CTYPE)[] initialElements) {
     this();
@@ -35,7 +40,14 @@ SWIGINTERN jint SWIG_VectorSize(size_t size) {
       add(element);
     }
   }
+%}
+SWIG_STD_VECTOR_COMMON_INTERNAL(CTYPE, CONST_REFERENCE)
+%enddef
 
+%define SWIG_STD_VECTOR_COMMON_INTERNAL(CTYPE, CONST_REFERENCE)
+%typemap(javabase) std::vector< CTYPE > "java.util.AbstractList<$typemap(jboxtype, CTYPE)>"
+%typemap(javainterfaces) std::vector< CTYPE > "java.util.RandomAccess"
+%proxycode %{
   public $javaclassname(Iterable<$typemap(jboxtype, CTYPE)> initialElements) {
     this();
     for ($typemap(jstype, CTYPE) element : initialElements) {
@@ -161,6 +173,72 @@ SWIGINTERN jint SWIG_VectorSize(size_t size) {
     }
 %enddef
 
+/* Pass the JNI environment to the bulk transfer methods */
+%typemap(in, numinputs=0) JNIEnv *SWIG_JNIENV "$1 = jenv;"
+
+%define SWIG_STD_VECTOR_PRIMITIVE_INTERNAL(CTYPE, JTYPE, JNITYPE, JNAME, BUFFERVIEW)
+%proxycode %{
+  public $javaclassname(JTYPE[] initialElements) {
+    this();
+    fromArray(initialElements);
+  }
+
+  public JTYPE[] toPrimitiveArray() {
+    return doToArray();
+  }
+
+  public void fromArray(JTYPE[] values) {
+    modCount++;
+    doAssign(values, false);
+  }
+
+  public boolean addAll(JTYPE[] values) {
+    modCount++;
+    doAssign(values, true);
+    return values.length != 0;
+  }
+%}
+SWIG_STD_VECTOR_COMMON_INTERNAL(CTYPE, const value_type&)
+    %extend {
+      JNITYPE##Array doToArray(JNIEnv *SWIG_JNIENV) const throw (std::out_of_range) {
+        jsize size = SWIG_VectorSize(self->size());
+        JNITYPE##Array result = SWIG_JNIENV->New##JNAME##Array(size);
+        if (result && size > 0)
+          SWIG_JNIENV->Set##JNAME##ArrayRegion(result, 0, size, reinterpret_cast<const JNITYPE *>(&(*self)[0]));
+        return result;
+      }
+
+      void doAssign(JNIEnv *SWIG_JNIENV, JNITYPE##Array values, bool append) throw (std::out_of_range) {
+        if (!values) {
+          SWIG_JavaThrowException(SWIG_JNIENV, SWIG_JavaNullPointerException, "null array");
+          return;
+        }
+        jsize size = SWIG_JNIENV->GetArrayLength(values);
+        std::vector< CTYPE >::size_type offset = append ? self->size() : 0;
+        SWIG_VectorSize(offset + size);
+        self->resize(offset + size);
+        if (size > 0)
+          SWIG_JNIENV->Get##JNAME##ArrayRegion(values, 0, size, reinterpret_cast<JNITYPE *>(&(*self)[offset]));
+      }
+    }
+#if defined(SWIG_JAVA_VECTOR_DIRECT_BUFFER)
+%proxycode %{
+  public java.nio.JNAME##Buffer asDirectBuffer() {
+    java.nio.ByteBuffer buffer = (java.nio.ByteBuffer)doDirectBuffer();
+    return buffer.order(java.nio.ByteOrder.nativeOrder()).BUFFERVIEW();
+  }
+%}
+    %extend {
+      jobject doDirectBuffer(JNIEnv *SWIG_JNIENV) {
+        return SWIG_JNIENV->NewDirectByteBuffer(self->empty() ? 0 : &(*self)[0], static_cast<jlong>(self->size() * sizeof(CTYPE)));
+      }
+    }
+#endif
+%enddef
+
+%javamethodmodifiers std::vector::doToArray      "private";
+%javamethodmodifiers std::vector::doAssign       "private";
+%javamethodmodifiers std::vector::doDirectBuffer "private";
 %javamethodmodifiers std::vector::doSize        "private";
 %javamethodmodifiers std::vector::doAdd         "private";
 %javamethodmodifiers std::vector::doGet         "private";
@@ -178,6 +256,26 @@ namespace std {
     template<> class vector<bool> {
         SWIG_STD_VECTOR_MINIMUM_INTERNAL(bool, bool)
     };
+
+    // Primitive specializations with bulk transfer methods
+    template<> class vector<signed char> {
+        SWIG_STD_VECTOR_PRIMITIVE_INTERNAL(signed char, byte, jbyte, Byte, slice)
+    };
+    template<> class vector<short> {
+        SWIG_STD_VECTOR_PRIMITIVE_INTERNAL(short, short, jshort, Short, asShortBuffer)
+    };
+    template<> class vector<int> {
+        SWIG_STD_VECTOR_PRIMITIVE_INTERNAL(int, int, jint, Int, asIntBuffer)
+    };
+    template<> class vector<long long> {
+        SWIG_STD_VECTOR_PRIMITIVE_INTERNAL(long long, long, jlong, Long, asLongBuffer)
+    };
+    template<> class vector<float> {
+        SWIG_STD_VECTOR_PRIMITIVE_INTERNAL(float, float, jfloat, Float, asFloatBuffer)
+    };
+    template<> class vector<double> {
+        SWIG_STD_VECTOR_PRIMITIVE_INTERNAL(double, double, jdouble, Double, asDoubleBuffer)
+    };
 }
 
 %define specialize_std_vector(T)
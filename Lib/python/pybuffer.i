@@ -118,4 +118,546 @@
 %enddef
 
 
+/* -----------------------------------------------------------------------------
+ * Zero-copy views of contiguous arrays
+ *
+ * The following exchange contiguous arrays of numbers with Python objects
+ * supporting the buffer protocol (PEP 3118), such as array.array, bytes,
+ * memoryview and NumPy arrays, without converting each element.
+ * ----------------------------------------------------------------------------- */
+
+/* The struct module format of the C types that can be viewed, used as
+   $typemap(pybufferformat, type) */
+%typemap(pybufferformat) char "c";
+%typemap(pybufferformat) signed char "b";
+%typemap(pybufferformat) unsigned char "B";
+%typemap(pybufferformat) short "h";
+%typemap(pybufferformat) unsigned short "H";
+%typemap(pybufferformat) int "i";
+%typemap(pybufferformat) unsigned int "I";
+%typemap(pybufferformat) long "l";
+%typemap(pybufferformat) unsigned long "L";
+%typemap(pybufferformat) long long "q";
+%typemap(pybufferformat) unsigned long long "Q";
+%typemap(pybufferformat) float "f";
+%typemap(pybufferformat) double "d";
+
+/* Whether the memory pointed to must be writable, as $typemap(pybufferwritable, type) */
+%typemap(pybufferwritable) SWIGTYPE * "1";
+%typemap(pybufferwritable) const SWIGTYPE * "0";
+
+%fragment("SwigPyBufferView", "header") %{
+/* Return the kind of the items described by a struct module format, 'i' for
+   signed integers, 'u' for unsigned integers, 'f' for floating point and 'c'
+   for char, or 0 if the items are not single numbers in the native byte order */
+SWIGINTERN char
+SWIG_Python_BufferFormatKind(const char *format) {
+  static const int one = 1;
+  if (!format)
+    return 'u';
+  switch (*format) {
+  case '@':
+  case '=':
+    format++;
+    break;
+  case '<':
+    if (!*(const char *)&one)
+      return 0;
+    format++;
+    break;
+  case '>':
+  case '!':
+    if (*(const char *)&one)
+      return 0;
+    format++;
+    break;
+  }
+  if (!format[0] || format[1])
+    return 0;
+  switch (*format) {
+  case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+    return 'i';
+  case 'B': case 'H': case 'I': case 'L': case 'Q': case 'N':
+    return 'u';
+  case 'f': case 'd':
+    return 'f';
+  case 'c':
+    return 'c';
+  default:
+    return 0;
+  }
+}
+
+/* Check that the items of a buffer can be used as an array of the C type with
+   the given format and size. A char array accepts any single byte integers. */
+SWIGINTERN int
+SWIG_Python_BufferCompatible(const Py_buffer *view, const char *format, size_t itemsize) {
+  char kind = SWIG_Python_BufferFormatKind(view->format);
+  char expected = SWIG_Python_BufferFormatKind(format);
+  if (!kind || view->itemsize != (Py_ssize_t)itemsize)
+    return 0;
+  return kind == expected || (expected == 'c' && itemsize == 1);
+}
+
+/* Get a C contiguous one dimensional buffer of items of the given format and
+   size from obj, which must be released with PyBuffer_Release() once the
+   items are no longer used. On failure the Python error is cleared. */
+SWIGINTERN int
+SWIG_Python_GetArrayBuffer(PyObject *obj, Py_buffer *view, const char *format, size_t itemsize, int writable) {
+  if (!PyObject_CheckBuffer(obj))
+    return SWIG_TypeError;
+  if (PyObject_GetBuffer(obj, view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (writable ? PyBUF_WRITABLE : 0)) < 0) {
+    PyErr_Clear();
+    return SWIG_TypeError;
+  }
+  if (view->ndim > 1 || !SWIG_Python_BufferCompatible(view, format, itemsize)) {
+    PyBuffer_Release(view);
+    return SWIG_TypeError;
+  }
+  return SWIG_OK;
+}
+
+/* An object exporting the memory of a C/C++ array, keeping the owner of the
+   memory alive for as long as the memory is viewed. If set, release is called
+   with release_data once the memory is no longer viewed. */
+typedef struct {
+  PyObject_HEAD
+  void *buf;
+  Py_ssize_t shape[1];
+  Py_ssize_t itemsize;
+  const char *format;
+  int readonly;
+  PyObject *owner;
+  void (*release)(void *);
+  void *release_data;
+} SwigPyBufferView;
+
+SWIGINTERN int
+SwigPyBufferView_getbuffer(PyObject *obj, Py_buffer *view, int flags) {
+  SwigPyBufferView *v = (SwigPyBufferView *)obj;
+  if ((flags & PyBUF_WRITABLE) && v->readonly) {
+    PyErr_SetString(PyExc_BufferError, "SWIG buffer view is read-only");
+    view->obj = NULL;
+    return -1;
+  }
+  view->obj = obj;
+  Py_INCREF(obj);
+  view->buf = v->buf;
+  view->len = v->shape[0] * v->itemsize;
+  view->readonly = v->readonly;
+  view->itemsize = v->itemsize;
+  view->format = (flags & PyBUF_FORMAT) ? (char *)v->format : NULL;
+  view->ndim = 1;
+  view->shape = (flags & PyBUF_ND) ? v->shape : NULL;
+  view->strides = (flags & PyBUF_STRIDES) ? &v->itemsize : NULL;
+  view->suboffsets = NULL;
+  view->internal = NULL;
+  return 0;
+}
+
+SWIGINTERN void
+SwigPyBufferView_dealloc(PyObject *obj) {
+  SwigPyBufferView *v = (SwigPyBufferView *)obj;
+  if (v->release)
+    v->release(v->release_data);
+  Py_XDECREF(v->owner);
+  PyObject_DEL(obj);
+}
+
+SWIGINTERN PyTypeObject*
+SwigPyBufferView_TypeOnce(void) {
+  static char swigpybufferview_doc[] = "Swig object exporting the memory of a C/C++ array";
+  static PyBufferProcs swigpybufferview_as_buffer = {
+#if PY_VERSION_HEX < 0x03000000
+    0,                                    /* bf_getreadbuffer */
+    0,                                    /* bf_getwritebuffer */
+    0,                                    /* bf_getsegcount */
+    0,                                    /* bf_getcharbuffer */
+#endif
+    SwigPyBufferView_getbuffer,           /* bf_getbuffer */
+    0                                     /* bf_releasebuffer */
+  };
+  static PyTypeObject swigpybufferview_type;
+  static int type_init = 0;
+  if (!type_init) {
+    const PyTypeObject tmp = {
+#if PY_VERSION_HEX>=0x03000000
+      PyVarObject_HEAD_INIT(NULL, 0)
+#else
+      PyObject_HEAD_INIT(NULL)
+      0,                                    /* ob_size */
+#endif
+      "SwigPyBufferView",                   /* tp_name */
+      sizeof(SwigPyBufferView),             /* tp_basicsize */
+      0,                                    /* tp_itemsize */
+      SwigPyBufferView_dealloc,             /* tp_dealloc */
+      0,                                    /* tp_print */
+      (getattrfunc)0,                       /* tp_getattr */
+      (setattrfunc)0,                       /* tp_setattr */
+      0,                                    /* tp_compare */
+      0,                                    /* tp_repr */
+      0,                                    /* tp_as_number */
+      0,                                    /* tp_as_sequence */
+      0,                                    /* tp_as_mapping */
+      (hashfunc)0,                          /* tp_hash */
+      (ternaryfunc)0,                       /* tp_call */
+      0,                                    /* tp_str */
+      PyObject_GenericGetAttr,              /* tp_getattro */
+      0,                                    /* tp_setattro */
+      &swigpybufferview_as_buffer,          /* tp_as_buffer */
+#if PY_VERSION_HEX>=0x03000000
+      Py_TPFLAGS_DEFAULT,                   /* tp_flags */
+#else
+      Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER, /* tp_flags */
+#endif
+      swigpybufferview_doc,                 /* tp_doc */
+      0,                                    /* tp_traverse */
+      0,                                    /* tp_clear */
+      0,                                    /* tp_richcompare */
+      0,                                    /* tp_weaklistoffset */
+      0,                                    /* tp_iter */
+      0,                                    /* tp_iternext */
+      0,                                    /* tp_methods */
+      0,                                    /* tp_members */
+      0,                                    /* tp_getset */
+      0,                                    /* tp_base */
+      0,                                    /* tp_dict */
+      0,                                    /* tp_descr_get */
+      0,                                    /* tp_descr_set */
+      0,                                    /* tp_dictoffset */
+      0,                                    /* tp_init */
+      0,                                    /* tp_alloc */
+      0,                                    /* tp_new */
+      0,                                    /* tp_free */
+      0,                                    /* tp_is_gc */
+      0,                                    /* tp_bases */
+      0,                                    /* tp_mro */
+      0,                                    /* tp_cache */
+      0,                                    /* tp_subclasses */
+      0,                                    /* tp_weaklist */
+      0,                                    /* tp_del */
+      0,                                    /* tp_version_tag */
+#if PY_VERSION_HEX >= 0x03040000
+      0,                                    /* tp_finalize */
+#endif
+#ifdef COUNT_ALLOCS
+      0,                                    /* tp_allocs */
+      0,                                    /* tp_frees */
+      0,                                    /* tp_maxalloc */
+      0,                                    /* tp_prev */
+      0                                     /* tp_next */
+#endif
+    };
+    swigpybufferview_type = tmp;
+    type_init = 1;
+    if (PyType_Ready(&swigpybufferview_type) < 0)
+      return NULL;
+  }
+  return &swigpybufferview_type;
+}
+
+/* Create an object exporting size items of the given format and size at buf.
+   A reference to owner, the Python object owning the memory, is held until
+   the object and all the views of it have gone. */
+SWIGINTERN PyObject *
+SwigPyBufferView_New(void *buf, size_t size, size_t itemsize, const char *format, int readonly, PyObject *owner) {
+  PyTypeObject *type = SwigPyBufferView_TypeOnce();
+  SwigPyBufferView *v = type ? PyObject_NEW(SwigPyBufferView, type) : NULL;
+  if (v) {
+    v->buf = buf;
+    v->shape[0] = (Py_ssize_t)size;
+    v->itemsize = (Py_ssize_t)itemsize;
+    v->format = format;
+    v->readonly = readonly;
+    v->owner = owner;
+    Py_XINCREF(owner);
+    v->release = 0;
+    v->release_data = 0;
+  }
+  return (PyObject *)v;
+}
+
+/* Return a memoryview of size items at buf, see SwigPyBufferView_New() */
+SWIGINTERN PyObject *
+SWIG_Python_NewMemoryView(void *buf, size_t size, size_t itemsize, const char *format, int readonly, PyObject *owner) {
+  PyObject *view = NULL;
+  PyObject *obj = SwigPyBufferView_New(buf, size, itemsize, format, readonly, owner);
+  if (obj) {
+    view = PyMemoryView_FromObject(obj);
+    Py_DECREF(obj);
+  }
+  return view;
+}
+%}
 
+/* %python_buffer_array(TYPEMAP, SIZE)
+ *
+ * Macro for functions taking a pointer to an array of numbers and the number
+ * of items. Any contiguous one dimensional Python buffer with items of the
+ * same type can be passed, and the function works directly on its memory,
+ * which is kept valid until the function returns. The buffer must be writable
+ * unless the pointer is to const items. For example:
+ *
+ *      %python_buffer_array(double *data, size_t n);
+ *      void scale(double *data, size_t n, double factor);
+ *
+ *      >>> a = array.array('d', [1.0, 2.0])
+ *      >>> scale(a, 2.0)
+ */
+
+%define %python_buffer_array(TYPEMAP, SIZE)
+%typemap(in, fragment="SwigPyBufferView") (TYPEMAP, SIZE) (Py_buffer view, int viewok = 0) {
+  int res = SWIG_Python_GetArrayBuffer($input, &view, "$typemap(pybufferformat, $*1_ltype)", sizeof($*1_ltype), $typemap(pybufferwritable, $1_type));
+  if (!SWIG_IsOK(res)) {
+    %argument_fail(res, "(TYPEMAP, SIZE)", $symname, $argnum);
+  }
+  viewok = 1;
+  $1 = ($1_ltype) view.buf;
+  $2 = ($2_ltype) (view.len / view.itemsize);
+}
+%typemap(freearg) (TYPEMAP, SIZE) {
+  if (viewok$argnum) PyBuffer_Release(&view$argnum);
+}
+%typemap(typecheck, precedence=SWIG_TYPECHECK_POINTER, fragment="SwigPyBufferView") (TYPEMAP, SIZE) {
+  Py_buffer view;
+  $1 = SWIG_IsOK(SWIG_Python_GetArrayBuffer($input, &view, "$typemap(pybufferformat, $*1_ltype)", sizeof($*1_ltype), 0));
+  if ($1) PyBuffer_Release(&view);
+}
+%enddef
+
+%fragment("SwigPyBufferView_T", "header", fragment="SwigPyBufferView", fragment="StdSequenceTraits") %{
+#include <cstring>
+#include <map>
+
+namespace swig {
+  /* The struct module format of the value types of the containers that can be viewed */
+  template <class Type> struct buffer_format { };
+  template <> struct buffer_format<char> { static const char *format() { return "c"; } };
+  template <> struct buffer_format<signed char> { static const char *format() { return "b"; } };
+  template <> struct buffer_format<unsigned char> { static const char *format() { return "B"; } };
+  template <> struct buffer_format<short> { static const char *format() { return "h"; } };
+  template <> struct buffer_format<unsigned short> { static const char *format() { return "H"; } };
+  template <> struct buffer_format<int> { static const char *format() { return "i"; } };
+  template <> struct buffer_format<unsigned int> { static const char *format() { return "I"; } };
+  template <> struct buffer_format<long> { static const char *format() { return "l"; } };
+  template <> struct buffer_format<unsigned long> { static const char *format() { return "L"; } };
+#ifdef SWIG_LONG_LONG_AVAILABLE
+  template <> struct buffer_format<long long> { static const char *format() { return "q"; } };
+  template <> struct buffer_format<unsigned long long> { static const char *format() { return "Q"; } };
+#endif
+  template <> struct buffer_format<float> { static const char *format() { return "f"; } };
+  template <> struct buffer_format<double> { static const char *format() { return "d"; } };
+
+  /* Give seq n items, only vectors can change their size */
+  template <class Seq>
+  inline bool buffer_resize(Seq &seq, size_t n) {
+    return seq.size() == n;
+  }
+
+  template <class T, class Alloc>
+  inline bool buffer_resize(std::vector<T, Alloc> &seq, size_t n) {
+    seq.resize(n);
+    return true;
+  }
+
+  /* Whether the memory of seq can move when its size changes, only for vectors */
+  template <class Seq>
+  inline bool buffer_resizable(const Seq *) {
+    return false;
+  }
+
+  template <class T, class Alloc>
+  inline bool buffer_resizable(const std::vector<T, Alloc> *) {
+    return true;
+  }
+
+  template <class Seq>
+  struct buffer_view {
+    typedef typename Seq::value_type value_type;
+    typedef std::map<const Seq *, Py_ssize_t> export_map;
+
+    /* The number of objects exporting the memory of each container */
+    static export_map &exports() {
+      static export_map m;
+      return m;
+    }
+
+    static void release(void *seq) {
+      typename export_map::iterator it = exports().find(static_cast<const Seq *>(seq));
+      if (it != exports().end() && --it->second == 0)
+	exports().erase(it);
+    }
+
+    /* Whether the memory of seq is viewed, when seq must not change its size */
+    static bool exported(const Seq *seq) {
+      return exports().find(seq) != exports().end();
+    }
+
+    /* Raise BufferError, as for bytearray, if the method wrapped by symname may change
+       the size of seq while it is viewed */
+    static bool resizing(const Seq *seq, const char *symname) {
+      static const char *const methods[] = {
+	"append", "push_back", "pop", "pop_back", "resize", "reserve", "clear", "insert", "erase", "assign",
+	"swap", "__delitem__", "__delslice__", "__setslice__", "__setitem__", 0
+      };
+      if (!buffer_resizable(seq) || !exported(seq))
+	return false;
+      size_t len = std::strlen(symname);
+      for (const char *const *method = methods; *method; ++method) {
+	size_t n = std::strlen(*method);
+	if (len > n && symname[len - n - 1] == '_' && std::strcmp(symname + len - n, *method) == 0) {
+	  PyErr_SetString(PyExc_BufferError, "Existing exports of data: object cannot be re-sized");
+	  return true;
+	}
+      }
+      return false;
+    }
+
+    /* An object exporting the items of seq, owned by the Python object owner */
+    static PyObject *exporter(Seq *seq, PyObject *owner) {
+      PyObject *obj = SwigPyBufferView_New(seq->empty() ? 0 : &(*seq)[0], seq->size(), sizeof(value_type),
+					   buffer_format<value_type>::format(), 0, owner);
+      if (obj) {
+	((SwigPyBufferView *)obj)->release = release;
+	((SwigPyBufferView *)obj)->release_data = seq;
+	++exports()[seq];
+      }
+      return obj;
+    }
+
+    /* A memoryview of the items of seq, owned by the Python object owner */
+    static PyObject *memoryview(Seq *seq, PyObject *owner) {
+      PyObject *view = NULL;
+      PyObject *obj = exporter(seq, owner);
+      if (obj) {
+	view = PyMemoryView_FromObject(obj);
+	Py_DECREF(obj);
+      }
+      return view;
+    }
+
+    /* The bf_getbuffer slot of the builtin type */
+    static int getbuffer(PyObject *obj, Py_buffer *view, int flags) {
+      Seq *seq = 0;
+      PyObject *source;
+      int res;
+      if (!SWIG_IsOK(SWIG_ConvertPtr(obj, (void **)&seq, swig::type_info<Seq>(), 0)) || !seq) {
+	PyErr_SetString(PyExc_BufferError, "invalid SWIG container");
+	view->obj = NULL;
+	return -1;
+      }
+      source = exporter(seq, obj);
+      if (!source) {
+	view->obj = NULL;
+	return -1;
+      }
+      res = PyObject_GetBuffer(source, view, flags);
+      Py_DECREF(source);
+      return res;
+    }
+
+    /* Copy the items of a Python buffer into a new container with a single
+       memcpy, only checking that this is possible if seq is null */
+    static int asptr(PyObject *obj, Seq **seq) {
+      Py_buffer view;
+      int res;
+      if (!PyObject_CheckBuffer(obj) || SWIG_Python_GetSwigThis(obj))
+	return SWIG_ERROR;
+      res = SWIG_Python_GetArrayBuffer(obj, &view, buffer_format<value_type>::format(), sizeof(value_type), 0);
+      if (!SWIG_IsOK(res))
+	return res;
+      size_t n = (size_t)(view.len / view.itemsize);
+      Seq *p = new Seq();
+      if (buffer_resize(*p, n)) {
+	if (seq) {
+	  if (n)
+	    std::memcpy(&(*p)[0], view.buf, view.len);
+	  *seq = p;
+	  p = 0;
+	  res = SWIG_NEWOBJ;
+	} else {
+	  res = SWIG_OK;
+	}
+      } else {
+	res = SWIG_ERROR;
+      }
+      delete p;
+      PyBuffer_Release(&view);
+      return res;
+    }
+
+    /* Return a wrapped copy of seq, which can be viewed without converting
+       the items, instead of a tuple if the container type is wrapped */
+    static PyObject *from(const Seq &seq) {
+      swig_type_info *desc = swig::type_info<Seq>();
+      if (desc && desc->clientdata)
+	return SWIG_InternalNewPointerObj(new Seq(seq), desc, SWIG_POINTER_OWN);
+      return traits_from_stdseq<Seq>::from(seq);
+    }
+  };
+}
+%}
+
+/* %python_buffer_view(TYPE)
+ *
+ * Macro exposing the memory of a contiguous container of numbers, such as
+ * std::vector<double> or std::array<int, 3>, to Python without copying.
+ * The buffer_view() method returns a memoryview of the items, which keeps the
+ * container alive and can be passed to numpy.asarray() for example. With
+ * -builtin, or from Python 3.12 onwards, the container itself supports the
+ * buffer protocol. As for bytearray, methods changing the size of a vector,
+ * such as append() or resize(), raise BufferError while the memory is viewed.
+ * Python buffers of the same type of number, such as array.array or
+ * NumPy arrays, are copied into the container with a single memcpy when
+ * passed by value or const reference, and containers returned by value are
+ * returned as wrapped objects rather than tuples. Use before %template:
+ *
+ *      %python_buffer_view(std::vector<double>)
+ *      %template(DoubleVector) std::vector<double>;
+ */
+
+%define %python_buffer_view(TYPE...)
+%fragment("SwigPyBufferView_T");
+/* The methods changing the size are found by name, with check typemaps on self so that
+   any %exception for them still applies */
+%typemap(check, noblock=1) TYPE *self {
+  if (swig::buffer_view< TYPE >::resizing($1, "$symname")) SWIG_fail;
+}
+%typemap(check, noblock=1) (TYPE *self, TYPE &v) {
+  if (swig::buffer_view< TYPE >::resizing($1, "$symname") || swig::buffer_view< TYPE >::resizing($2, "$symname")) SWIG_fail;
+}
+/* Setting an item by index never changes the size */
+%typemap(check) (TYPE *self, TYPE::difference_type i, const TYPE::value_type &x), (TYPE *self, TYPE::difference_type i, TYPE::value_type x) ""
+%{
+namespace swig {
+  template <>
+  struct traits_asptr<TYPE > {
+    static int asptr(PyObject *obj, TYPE **seq) {
+      int res = buffer_view<TYPE >::asptr(obj, seq);
+      return SWIG_IsOK(res) ? res : traits_asptr_stdseq<TYPE >::asptr(obj, seq);
+    }
+  };
+
+  template <>
+  struct traits_from<TYPE > {
+    static PyObject *from(const TYPE &seq) {
+      return buffer_view<TYPE >::from(seq);
+    }
+  };
+}
+%}
+#if defined(SWIGPYTHON_BUILTIN)
+%feature("python:bf_getbuffer", %arg("swig::buffer_view< TYPE >::getbuffer")) TYPE;
+#endif
+%extend TYPE {
+  PyObject *buffer_view(PyObject **PYTHON_SELF) {
+    return swig::buffer_view< TYPE >::memoryview($self, *PYTHON_SELF);
+  }
+#if !defined(SWIGPYTHON_BUILTIN)
+  PyObject *__buffer__(PyObject **PYTHON_SELF, int flags) {
+    (void)flags;
+    return swig::buffer_view< TYPE >::memoryview($self, *PYTHON_SELF);
+  }
+#endif
+}
+%enddef
@@ -106,6 +106,7 @@
 #define DohCopyto          DOH_NAMESPACE(Copyto)
 #define DohNewList         DOH_NAMESPACE(NewList)
 #define DohNewHash         DOH_NAMESPACE(NewHash)
+#define DohInternKey       DOH_NAMESPACE(InternKey)
 #define DohNewVoid         DOH_NAMESPACE(NewVoid)
 #define DohSplit           DOH_NAMESPACE(Split)
 #define DohSplitLines      DOH_NAMESPACE(SplitLines)
@@ -113,6 +114,9 @@
 #define DohCall            DOH_NAMESPACE(Call)
 #define DohObjMalloc       DOH_NAMESPACE(ObjMalloc)
 #define DohObjFree         DOH_NAMESPACE(ObjFree)
+#define DohSlabMalloc      DOH_NAMESPACE(SlabMalloc)
+#define DohSlabRealloc     DOH_NAMESPACE(SlabRealloc)
+#define DohSlabFree        DOH_NAMESPACE(SlabFree)
 #define DohMemoryDebug     DOH_NAMESPACE(MemoryDebug)
 #define DohStringType      DOH_NAMESPACE(StringType)
 #define DohListType        DOH_NAMESPACE(ListType)
@@ -322,6 +326,7 @@ extern void DohSortList(DOH *lo, int (*cmp) (const DOH *, const DOH *));
  * ----------------------------------------------------------------------------- */
 
 extern DOHHash *DohNewHash(void);
+extern DOHString *DohInternKey(const char *c);
 
 /* -----------------------------------------------------------------------------
  * Void
@@ -414,6 +419,7 @@ extern void DohMemoryDebug(void);
 #define NewStringWithSize  DohNewStringWithSize
 #define NewStringf         DohNewStringf
 #define NewHash            DohNewHash
+#define InternKey          DohInternKey
 #define NewList            DohNewList
 #define NewFile            DohNewFile
 #define NewFileFromFile    DohNewFileFromFile
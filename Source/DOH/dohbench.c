@@ -0,0 +1,137 @@
+/* -----------------------------------------------------------------------------
+ * This file is part of SWIG, which is licensed as a whole under version 3
+ * (or any later version) of the GNU General Public License. Some additional
+ * terms also apply to certain portions of SWIG. The full details of the SWIG
+ * license and copyrights can be found in the LICENSE and COPYRIGHT files
+ * included with the SWIG source code as distributed by the SWIG developers
+ * and at http://www.swig.org/legal.html.
+ *
+ * dohbench.c
+ *
+ *     Microbenchmark for the DOH Hash and String objects. The workloads mimic
+ *     the way SWIG uses DOH: many small parse tree node hashes accessed with
+ *     C string attribute keys and a few large tables keyed by long mangled
+ *     type names.  Build with 'make dohbench' in the Source directory.
+ *
+ *     Usage: dohbench [scale]
+ * ----------------------------------------------------------------------------- */
+
+#include "doh.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char *attribute_keys[] = {
+  "name", "type", "decl", "sym:name", "sym:symtab", "storage", "parms", "value",
+  "kind", "access", "code", "feature:ignore", "sym:overname", "nodeType", "parentNode",
+  "firstChild", "nextSibling", "lastChild", "wrap:name", "tmap:in", "tmap:out", 0
+};
+
+static double elapsed(clock_t start) {
+  return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+/* Parse tree like usage: many small hashes with C string keys */
+static void bench_nodes(int scale) {
+  int nnodes = 2000 * scale;
+  int i, j, k;
+  long found = 0;
+  DOHList *nodes = NewList();
+  clock_t start = clock();
+
+  for (i = 0; i < nnodes; i++) {
+    DOHHash *n = NewHash();
+    for (j = 0; attribute_keys[j]; j++) {
+      DOHString *v = NewStringf("value%d_%d", i, j);
+      Setattr(n, attribute_keys[j], v);
+      Delete(v);
+    }
+    Append(nodes, n);
+    Delete(n);
+  }
+  printf("  node Setattr:           %8.3f s\n", elapsed(start));
+
+  start = clock();
+  for (k = 0; k < 20; k++) {
+    for (i = 0; i < nnodes; i++) {
+      DOHHash *n = Getitem(nodes, i);
+      for (j = 0; attribute_keys[j]; j++) {
+	if (Getattr(n, attribute_keys[j]))
+	  found++;
+      }
+      if (Getattr(n, "missing:attribute"))
+	found++;
+    }
+  }
+  printf("  node Getattr:           %8.3f s (%ld found)\n", elapsed(start), found);
+
+  start = clock();
+  for (i = 0; i < nnodes; i++) {
+    DOHHash *n = Getitem(nodes, i);
+    DOHHash *c = Copy(n);
+    Iterator ki;
+    for (ki = First(c); ki.key; ki = Next(ki)) {
+      if (Strncmp(ki.key, "sym:", 4) == 0)
+	Delattr(c, ki.key);
+    }
+    Delete(c);
+  }
+  printf("  node Copy+Delattr:      %8.3f s\n", elapsed(start));
+  Delete(nodes);
+}
+
+/* Type table like usage: a large hash keyed by long mangled names */
+static void bench_types(int scale) {
+  int ntypes = 2000 * scale;
+  int i, k;
+  long found = 0;
+  DOHHash *types = NewHash();
+  DOHList *keys = NewList();
+  clock_t start;
+
+  for (i = 0; i < ntypes; i++) {
+    DOHString *key = NewStringf("_p_std__vectorT_std__mapT_std__string_std__vectorT_double_std__allocatorT_double_t_t_%d_t_t", i);
+    Append(keys, key);
+    Delete(key);
+  }
+
+  start = clock();
+  for (i = 0; i < ntypes; i++) {
+    Setattr(types, Getitem(keys, i), Getitem(keys, i));
+  }
+  printf("  type Setattr:           %8.3f s\n", elapsed(start));
+
+  start = clock();
+  for (k = 0; k < 10; k++) {
+    for (i = 0; i < ntypes; i++) {
+      /* fresh strings, so the hash value is not already cached */
+      DOHString *key = Copy(Getitem(keys, i));
+      Append(key, "");
+      if (Getattr(types, key))
+	found++;
+      Delete(key);
+    }
+  }
+  printf("  type Getattr:           %8.3f s (%ld found)\n", elapsed(start), found);
+
+  start = clock();
+  for (i = 0; i < ntypes; i += 2) {
+    Delattr(types, Getitem(keys, i));
+  }
+  printf("  type Delattr:           %8.3f s (%d left)\n", elapsed(start), Len(types));
+  Delete(types);
+  Delete(keys);
+}
+
+int main(int argc, char *argv[]) {
+  int scale = argc > 1 ? atoi(argv[1]) : 10;
+  clock_t start = clock();
+  if (scale < 1)
+    scale = 1;
+  printf("DOH benchmark (scale %d)\n", scale);
+  bench_nodes(scale);
+  bench_types(scale);
+  printf("  total:                  %8.3f s\n", elapsed(start));
+  return 0;
+}
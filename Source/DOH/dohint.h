@@ -127,5 +127,11 @@ typedef struct {
 
 extern DOH *DohObjMalloc(DohObjInfo *type, void *data);	/* Allocate a DOH object */
 extern void DohObjFree(DOH *ptr);	/* Free a DOH object     */
+extern int DohStringHashval(const char *str, int len);	/* String hash function */
+
+/* Size class allocator for object payloads and buffers */
+extern void *DohSlabMalloc(size_t size);
+extern void *DohSlabRealloc(void *ptr, size_t oldsize, size_t newsize);
+extern void DohSlabFree(void *ptr, size_t size);
 
 #endif				/* DOHINT_H */
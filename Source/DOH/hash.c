@@ -15,153 +15,276 @@
 
 extern DohObjInfo DohHashType;
 
-/* Hash node */
+/* Hash node.  Nodes are kept in a dense array in insertion order. A node
+   with a null key is a deleted node. */
 typedef struct HashNode {
   DOH *key;
   DOH *object;
-  struct HashNode *next;
+  int hashval;
+  int chainval;			/* Hash value used for the iteration order */
+  int chainnext;		/* Next node in the same iteration bucket */
 } HashNode;
 
-/* Hash object */
+/* Hash object.
+
+   The hash table uses open addressing with Robin Hood probing.  The index
+   table holds, for each slot, the position of a node in the nodes array or
+   HASH_EMPTY.  Keeping the nodes separate from the index keeps the index
+   small and cache friendly.
+
+   Iteration visits the items in the same order as the chained hash table
+   used by earlier versions of SWIG: bucket by bucket, with a bucket chosen
+   by a hash of the first 50 characters of the key modulo a prime table size,
+   and in insertion order within a bucket.  Much of the generated code, such as
+   the equivalent type names and the cast lists in the type tables, is
+   produced by iterating over hashes, so keeping this order keeps the
+   generated code unchanged.  These buckets are only used for iteration and
+   are chained through the nodes array. */
 typedef struct Hash {
   DOH *file;
   int line;
-  HashNode **hashtable;
-  int hashsize;
-  int nitems;
+  int *index;			/* Open addressing index table into nodes */
+  int indexsize;		/* Size of index table, always a power of 2 */
+  HashNode *nodes;		/* Nodes in insertion order */
+  int nodessize;		/* Number of nodes allocated */
+  int nnodes;			/* Number of nodes used, including deleted nodes */
+  int nitems;			/* Number of items in the hash */
+  int *chains;			/* First node in each iteration bucket */
+  int chainsize;		/* Number of iteration buckets */
 } Hash;
 
-/* Key interning structure */
+/* Key interning table.  C string keys are interned as String objects so
+   that each key's hash value is calculated once and stored in the interned
+   String.  The table uses open addressing with linear probing and keeps the
+   hash value alongside each interned key so that most mismatches are rejected
+   without a string comparison. */
 typedef struct KeyValue {
-  char *cstr;
+  int hashval;
+  int len;
+  const char *cstr;		/* The interned String's data */
   DOH *sstr;
-  struct KeyValue *left;
-  struct KeyValue *right;
 } KeyValue;
 
-static KeyValue *root = 0;
+static KeyValue *keys = 0;
+static int keys_size = 0;	/* Always a power of 2 */
+static int keys_count = 0;
 static int max_expand = 1;
 
+#define KEYS_INIT_SIZE 1024
+
+/* Grow the key interning table */
+static void resize_keys(void) {
+  KeyValue *oldkeys = keys;
+  int oldsize = keys_size;
+  int i;
+
+  keys_size = keys_size ? keys_size * 2 : KEYS_INIT_SIZE;
+  keys = (KeyValue *) DohMalloc(keys_size * sizeof(KeyValue));
+  for (i = 0; i < keys_size; i++)
+    keys[i].sstr = 0;
+  for (i = 0; i < oldsize; i++) {
+    if (oldkeys[i].sstr) {
+      int slot = oldkeys[i].hashval & (keys_size - 1);
+      while (keys[slot].sstr)
+	slot = (slot + 1) & (keys_size - 1);
+      keys[slot] = oldkeys[i];
+    }
+  }
+  DohFree(oldkeys);
+}
+
 /* Find or create a key in the interned key table */
 static DOH *find_key(DOH *doh_c) {
-  char *c = (char *) doh_c;
-  KeyValue *r, *s;
-  int d = 0;
-  /* OK, sure, we use a binary tree for maintaining interned
-     symbols.  Then we use their hash values for accessing secondary
-     hash tables. */
-  r = root;
-  s = 0;
-  while (r) {
-    s = r;
-    d = strcmp(r->cstr, c);
-    if (d == 0)
+  const char *c = (const char *) doh_c;
+  int len = (int) strlen(c);
+  int hv = DohStringHashval(c, len);
+  int slot;
+
+  if (keys_size == 0)
+    resize_keys();
+
+  slot = hv & (keys_size - 1);
+  while (keys[slot].sstr) {
+    KeyValue *r = &keys[slot];
+    if ((r->hashval == hv) && (r->len == len) && (memcmp(r->cstr, c, len) == 0))
       return r->sstr;
-    if (d < 0)
-      r = r->left;
-    else
-      r = r->right;
+    slot = (slot + 1) & (keys_size - 1);
   }
+
   /*  fprintf(stderr,"Interning '%s'\n", c); */
-  r = (KeyValue *) DohMalloc(sizeof(KeyValue));
-  r->cstr = (char *) DohMalloc(strlen(c) + 1);
-  strcpy(r->cstr, c);
-  r->sstr = NewString(c);
-  DohIntern(r->sstr);
-  r->left = 0;
-  r->right = 0;
-  if (!s) {
-    root = r;
-  } else {
-    if (d < 0)
-      s->left = r;
-    else
-      s->right = r;
+  if (2 * (keys_count + 1) > keys_size) {
+    resize_keys();
+    slot = hv & (keys_size - 1);
+    while (keys[slot].sstr)
+      slot = (slot + 1) & (keys_size - 1);
   }
-  return r->sstr;
+  keys[slot].sstr = NewString(c);
+  DohIntern(keys[slot].sstr);
+  Hashval(keys[slot].sstr);	/* caches the hash value in the String */
+  keys[slot].cstr = Char(keys[slot].sstr);
+  keys[slot].len = len;
+  keys[slot].hashval = hv;
+  keys_count++;
+  return keys[slot].sstr;
 }
 
-#define HASH_INIT_SIZE   7
+/* -----------------------------------------------------------------------------
+ * DohInternKey()
+ *
+ * Returns the interned String for a C string key.  The returned String is
+ * never deleted and can be used as a key instead of the C string, which saves
+ * the key lookup on each Getattr()/Setattr() call.
+ * ----------------------------------------------------------------------------- */
 
-/* Create a new hash node */
-static HashNode *NewNode(DOH *k, void *obj) {
-  HashNode *hn = (HashNode *) DohMalloc(sizeof(HashNode));
-  hn->key = k;
-  Incref(hn->key);
-  hn->object = obj;
-  Incref(obj);
-  hn->next = 0;
-  return hn;
+DOHString *DohInternKey(const char *c) {
+  return find_key((DOH *) c);
 }
 
-/* Delete a hash node */
-static void DelNode(HashNode *hn) {
-  Delete(hn->key);
-  Delete(hn->object);
-  DohFree(hn);
-}
+#define HASH_INIT_SIZE   16	/* Initial index size, must be a power of 2 */
+#define HASH_EMPTY       -1
+#define HASH_CHAIN_INIT_SIZE 7	/* Initial number of iteration buckets */
+#define HASH_CHAIN_END   -1
 
-/* -----------------------------------------------------------------------------
- * DelHash()
- *
- * Delete a hash table.
- * ----------------------------------------------------------------------------- */
+/* Maximum number of nodes for a given index size (load factor 0.75) */
+#define HASH_MAX_NODES(indexsize) (((indexsize) >> 2) * 3)
 
-static void DelHash(DOH *ho) {
-  Hash *h = (Hash *) ObjData(ho);
-  HashNode *n, *next;
-  int i;
+/* Distance of the node referenced by index slot 'slot' from its home slot */
+#define HASH_PROBE_DISTANCE(h, slot) (((slot) - (h)->nodes[(h)->index[slot]].hashval) & ((h)->indexsize - 1))
 
-  for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      next = n->next;
-      DelNode(n);
-      n = next;
+typedef int (*binop) (DOH *obj1, DOH *obj2);
+
+/* Find the index slot for key k with hash value hv. Returns -1 if not found. */
+static int find_slot(Hash *h, DOH *k, int hv) {
+  DohObjInfo *k_type = ((DohBase *) k)->type;
+  binop equal = k_type->doh_equal;
+  binop cmp = k_type->doh_cmp;
+  int mask = h->indexsize - 1;
+  int slot = hv & mask;
+  int distance = 0;
+
+  if (!h->nitems)
+    return -1;
+
+  while (h->index[slot] != HASH_EMPTY) {
+    HashNode *n = &h->nodes[h->index[slot]];
+    if (HASH_PROBE_DISTANCE(h, slot) < distance) {
+      /* Robin Hood invariant: the key would have displaced this node */
+      return -1;
     }
+    if (n->hashval == hv) {
+      DohBase *nk = (DohBase *) n->key;
+      if ((DOH *) nk == k)
+	return slot;		/* Same interned key */
+      if ((k_type == nk->type) && (equal ? equal(k, nk) : (cmp(k, nk) == 0)))
+	return slot;
+    }
+    slot = (slot + 1) & mask;
+    distance++;
   }
-  DohFree(h->hashtable);
-  h->hashtable = 0;
-  h->hashsize = 0;
-  DohFree(h);
+  return -1;
 }
 
-/* -----------------------------------------------------------------------------
- * Hash_clear()
- *
- * Clear all of the entries in the hash table.
- * ----------------------------------------------------------------------------- */
+/* Place node number 'node' into the index table */
+static void insert_index(Hash *h, int node) {
+  int mask = h->indexsize - 1;
+  int slot = h->nodes[node].hashval & mask;
+  int distance = 0;
+
+  while (h->index[slot] != HASH_EMPTY) {
+    int d = HASH_PROBE_DISTANCE(h, slot);
+    if (d < distance) {
+      /* Steal the slot from the richer node and carry on placing that one */
+      int tmp = h->index[slot];
+      h->index[slot] = node;
+      node = tmp;
+      distance = d;
+    }
+    slot = (slot + 1) & mask;
+    distance++;
+  }
+  h->index[slot] = node;
+}
 
-static void Hash_clear(DOH *ho) {
-  Hash *h = (Hash *) ObjData(ho);
-  HashNode *n, *next;
-  int i;
+/* Remove the entry in index slot 'slot' using backward shift deletion */
+static void remove_index(Hash *h, int slot) {
+  int mask = h->indexsize - 1;
+  int next = (slot + 1) & mask;
+  while ((h->index[next] != HASH_EMPTY) && (HASH_PROBE_DISTANCE(h, next) > 0)) {
+    h->index[slot] = h->index[next];
+    slot = next;
+    next = (next + 1) & mask;
+  }
+  h->index[slot] = HASH_EMPTY;
+}
 
-  for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      next = n->next;
-      DelNode(n);
-      n = next;
-    }
-    h->hashtable[i] = 0;
+/* Hash value for the iteration order, the string hash used by earlier
+   versions of SWIG */
+static int chain_hashval(DOH *k) {
+  const char *c;
+  unsigned int len, mlen, i;
+  unsigned int h = 0;
+
+  if (!((DohBase *) k)->type->doh_hashval)
+    return 0;
+  c = Char(k);
+  len = (unsigned int) Len(k);
+  if (len > 50)
+    len = 50;
+  mlen = len >> 2;
+  for (i = mlen; i; --i) {
+    h = (h << 5) + *(c++);
+    h = (h << 5) + *(c++);
+    h = (h << 5) + *(c++);
+    h = (h << 5) + *(c++);
   }
-  h->nitems = 0;
+  for (i = len - (mlen << 2); i; --i) {
+    h = (h << 5) + *(c++);
+  }
+  h &= 0x7fffffff;
+  return (int) h;
 }
 
-/* resize the hash table */
-static void resize(Hash *h) {
-  HashNode *n, *next, **table;
+/* Allocate 'size' empty iteration buckets */
+static int *chain_buckets(int size) {
+  int *chains = (int *) DohSlabMalloc(size * sizeof(int));
+  int i;
+  for (i = 0; i < size; i++)
+    chains[i] = HASH_CHAIN_END;
+  return chains;
+}
+
+/* Add node number 'node' to the end of its iteration bucket */
+static void chain_add(Hash *h, int node) {
+  int *p;
+  if (!h->chains)
+    h->chains = chain_buckets(h->chainsize);
+  p = &h->chains[h->nodes[node].chainval % h->chainsize];
+  while (*p != HASH_CHAIN_END)
+    p = &h->nodes[*p].chainnext;
+  *p = node;
+  h->nodes[node].chainnext = HASH_CHAIN_END;
+}
+
+/* Unlink node number 'node' from its iteration bucket.  The node's own link is
+   left alone so that an iterator positioned on it can still move on. */
+static void chain_remove(Hash *h, int node) {
+  int *p = &h->chains[h->nodes[node].chainval % h->chainsize];
+  while (*p != node)
+    p = &h->nodes[*p].chainnext;
+  *p = h->nodes[node].chainnext;
+}
+
+/* Grow the iteration buckets once there are twice as many items as buckets,
+   in the same way as the old chained hash table did */
+static void chain_resize(Hash *h) {
+  int *chains;
   int oldsize, newsize;
-  int i, p, hv;
+  int i, p;
 
-  if (h->nitems < 2 * h->hashsize)
+  if (h->nitems < 2 * h->chainsize)
     return;
 
-  /* Too big. We have to rescale everything now */
-  oldsize = h->hashsize;
-
-  /* Calculate a new size */
+  oldsize = h->chainsize;
   newsize = 2 * oldsize + 1;
   p = 3;
   while (p < (newsize >> 1)) {
@@ -173,25 +296,122 @@ static void resize(Hash *h) {
     p = p + 2;
   }
 
-  table = (HashNode **) DohMalloc(newsize * sizeof(HashNode *));
-  for (i = 0; i < newsize; i++) {
-    table[i] = 0;
-  }
-
-  /* Walk down the old set of nodes and re-place */
-  h->hashsize = newsize;
+  chains = chain_buckets(newsize);
   for (i = 0; i < oldsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      hv = Hashval(n->key) % newsize;
-      next = n->next;
-      n->next = table[hv];
-      table[hv] = n;
+    int n = h->chains[i];
+    while (n != HASH_CHAIN_END) {
+      HashNode *hn = &h->nodes[n];
+      int next = hn->chainnext;
+      int b = hn->chainval % newsize;
+      hn->chainnext = chains[b];
+      chains[b] = n;
       n = next;
     }
   }
-  DohFree(h->hashtable);
-  h->hashtable = table;
+  DohSlabFree(h->chains, oldsize * sizeof(int));
+  h->chains = chains;
+  h->chainsize = newsize;
+}
+
+/* Rebuild the index and nodes so that there is room for at least one more node.
+   Deleted nodes are squeezed out, preserving the insertion order. */
+static void resize(Hash *h) {
+  int i, j;
+  int newsize = HASH_INIT_SIZE;
+  HashNode *nodes;
+  int *moved = 0;
+
+  while (HASH_MAX_NODES(newsize) < 2 * h->nitems + 1)
+    newsize <<= 1;
+
+  if (h->nitems != h->nnodes)
+    moved = (int *) DohMalloc(h->nnodes * sizeof(int));
+  nodes = (HashNode *) DohSlabMalloc(HASH_MAX_NODES(newsize) * sizeof(HashNode));
+  for (i = 0, j = 0; i < h->nnodes; i++) {
+    if (h->nodes[i].key) {
+      if (moved)
+	moved[i] = j;
+      nodes[j++] = h->nodes[i];
+    }
+  }
+  if (moved) {
+    /* Deleted nodes are not in any iteration bucket, renumber the others */
+    for (i = 0; i < h->chainsize; i++) {
+      if (h->chains[i] != HASH_CHAIN_END)
+	h->chains[i] = moved[h->chains[i]];
+    }
+    for (i = 0; i < j; i++) {
+      if (nodes[i].chainnext != HASH_CHAIN_END)
+	nodes[i].chainnext = moved[nodes[i].chainnext];
+    }
+    DohFree(moved);
+  }
+  DohSlabFree(h->nodes, h->nodessize * sizeof(HashNode));
+  h->nodes = nodes;
+  h->nodessize = HASH_MAX_NODES(newsize);
+  h->nnodes = j;
+
+  if (newsize != h->indexsize) {
+    DohSlabFree(h->index, h->indexsize * sizeof(int));
+    h->index = (int *) DohSlabMalloc(newsize * sizeof(int));
+    h->indexsize = newsize;
+  }
+  for (i = 0; i < newsize; i++)
+    h->index[i] = HASH_EMPTY;
+  for (i = 0; i < h->nnodes; i++)
+    insert_index(h, i);
+}
+
+/* Delete all the nodes */
+static void clear_nodes(Hash *h) {
+  int i;
+  for (i = 0; i < h->nnodes; i++) {
+    HashNode *n = &h->nodes[i];
+    if (n->key) {
+      Delete(n->key);
+      Delete(n->object);
+    }
+  }
+  h->nnodes = 0;
+  h->nitems = 0;
+}
+
+/* -----------------------------------------------------------------------------
+ * DelHash()
+ *
+ * Delete a hash table.
+ * ----------------------------------------------------------------------------- */
+
+static void DelHash(DOH *ho) {
+  Hash *h = (Hash *) ObjData(ho);
+
+  clear_nodes(h);
+  DohSlabFree(h->nodes, h->nodessize * sizeof(HashNode));
+  DohSlabFree(h->index, h->indexsize * sizeof(int));
+  DohSlabFree(h->chains, h->chainsize * sizeof(int));
+  h->nodes = 0;
+  h->index = 0;
+  h->indexsize = 0;
+  DohSlabFree(h, sizeof(Hash));
+}
+
+/* -----------------------------------------------------------------------------
+ * Hash_clear()
+ *
+ * Clear all of the entries in the hash table.
+ * ----------------------------------------------------------------------------- */
+
+static void Hash_clear(DOH *ho) {
+  Hash *h = (Hash *) ObjData(ho);
+  int i;
+
+  clear_nodes(h);
+  for (i = 0; i < h->indexsize; i++)
+    h->index[i] = HASH_EMPTY;
+  if (h->chains) {
+    for (i = 0; i < h->chainsize; i++)
+      h->chains[i] = HASH_CHAIN_END;
+  }
 }
 
 /* -----------------------------------------------------------------------------
@@ -203,7 +423,8 @@ static void resize(Hash *h) {
 
 static int Hash_setattr(DOH *ho, DOH *k, DOH *obj) {
   int hv;
-  HashNode *n, *prev;
+  int slot;
+  HashNode *n;
   Hash *h = (Hash *) ObjData(ho);
 
   if (!obj) {
@@ -215,33 +436,35 @@ static int Hash_setattr(DOH *ho, DOH *k, DOH *obj) {
     obj = NewString((char *) obj);
     Decref(obj);
   }
-  hv = (Hashval(k)) % h->hashsize;
-  n = h->hashtable[hv];
-  prev = 0;
-  while (n) {
-    if (Cmp(n->key, k) == 0) {
-      /* Node already exists.  Just replace its contents */
-      if (n->object == obj) {
-	/* Whoa. Same object.  Do nothing */
-	return 1;
-      }
-      Delete(n->object);
-      n->object = obj;
-      Incref(obj);
-      return 1;			/* Return 1 to indicate a replacement */
-    } else {
-      prev = n;
-      n = n->next;
+  hv = Hashval(k);
+  slot = find_slot(h, k, hv);
+  if (slot >= 0) {
+    /* Node already exists.  Just replace its contents */
+    n = &h->nodes[h->index[slot]];
+    if (n->object == obj) {
+      /* Whoa. Same object.  Do nothing */
+      return 1;
     }
+    Delete(n->object);
+    n->object = obj;
+    Incref(obj);
+    return 1;			/* Return 1 to indicate a replacement */
   }
   /* Add this to the table */
-  n = NewNode(k, obj);
-  if (prev)
-    prev->next = n;
-  else
-    h->hashtable[hv] = n;
+  if (h->nnodes == h->nodessize)
+    resize(h);
+  n = &h->nodes[h->nnodes];
+  n->key = k;
+  Incref(k);
+  n->object = obj;
+  Incref(obj);
+  n->hashval = hv;
+  n->chainval = chain_hashval(k);
+  insert_index(h, h->nnodes);
+  chain_add(h, h->nnodes);
+  h->nnodes++;
   h->nitems++;
-  resize(h);
+  chain_resize(h);
   return 0;
 }
 
@@ -250,32 +473,11 @@ static int Hash_setattr(DOH *ho, DOH *k, DOH *obj) {
  *
  * Get an attribute from the hash table. Returns 0 if it doesn't exist.
  * ----------------------------------------------------------------------------- */
-typedef int (*binop) (DOH *obj1, DOH *obj2);
-
-
 static DOH *Hash_getattr(DOH *h, DOH *k) {
-  DOH *obj = 0;
   Hash *ho = (Hash *) ObjData(h);
   DOH *ko = DohCheck(k) ? k : find_key(k);
-  int hv = Hashval(ko) % ho->hashsize;
-  DohObjInfo *k_type = ((DohBase*)ko)->type;
-  HashNode *n = ho->hashtable[hv];
-  if (k_type->doh_equal) {
-    binop equal = k_type->doh_equal;
-    while (n) {
-      DohBase *nk = (DohBase *)n->key;
-      if ((k_type == nk->type) && equal(ko, nk)) obj = n->object;
-      n = n->next;
-    }
-  } else {
-    binop cmp = k_type->doh_cmp;
-    while (n) {
-      DohBase *nk = (DohBase *)n->key;
-      if ((k_type == nk->type) && (cmp(ko, nk) == 0)) obj = n->object;
-      n = n->next;
-    }
-  }
-  return obj;
+  int slot = find_slot(ho, ko, Hashval(ko));
+  return slot >= 0 ? ho->nodes[ho->index[slot]].object : 0;
 }
 
 /* -----------------------------------------------------------------------------
@@ -285,79 +487,74 @@ static DOH *Hash_getattr(DOH *h, DOH *k) {
  * ----------------------------------------------------------------------------- */
 
 static int Hash_delattr(DOH *ho, DOH *k) {
-  HashNode *n, *prev;
-  int hv;
+  HashNode *n;
+  int slot;
   Hash *h = (Hash *) ObjData(ho);
 
   if (!DohCheck(k))
     k = find_key(k);
-  hv = Hashval(k) % h->hashsize;
-  n = h->hashtable[hv];
-  prev = 0;
-  while (n) {
-    if (Cmp(n->key, k) == 0) {
-      /* Found it, kill it */
-
-      if (prev) {
-	prev->next = n->next;
-      } else {
-	h->hashtable[hv] = n->next;
-      }
-      DelNode(n);
-      h->nitems--;
-      return 1;
+  slot = find_slot(h, k, Hashval(k));
+  if (slot < 0)
+    return 0;
+
+  /* Found it, kill it. The node is left in place, marked as deleted, so that
+     iterators remain valid */
+  n = &h->nodes[h->index[slot]];
+  chain_remove(h, h->index[slot]);
+  remove_index(h, slot);
+  Delete(n->key);
+  Delete(n->object);
+  n->key = 0;
+  n->object = 0;
+  h->nitems--;
+  return 1;
+}
+
+/* Returns the node in use following node i in iteration order, starting with
+   the first node in bucket b if i is HASH_CHAIN_END.  Returns HASH_CHAIN_END
+   after the last node. */
+static int chain_next(Hash *h, int i, int b) {
+  for (;;) {
+    while (i == HASH_CHAIN_END) {
+      if (b >= h->chainsize || !h->chains)
+	return HASH_CHAIN_END;
+      i = h->chains[b++];
     }
-    prev = n;
-    n = n->next;
+    if (h->nodes[i].key)
+      return i;
+    /* A deleted node, still linked to the node that followed it */
+    b = h->nodes[i].chainval % h->chainsize + 1;
+    i = h->nodes[i].chainnext;
   }
-  return 0;
+}
+
+static DohIterator hash_iter(DohIterator iter, int i) {
+  Hash *h = (Hash *) ObjData(iter.object);
+  iter._index = i;
+  if (i != HASH_CHAIN_END) {
+    iter.key = h->nodes[i].key;
+    iter.item = h->nodes[i].object;
+  } else {
+    iter.key = 0;
+    iter.item = 0;
+  }
+  return iter;
 }
 
 static DohIterator Hash_firstiter(DOH *ho) {
   DohIterator iter;
-  Hash *h = (Hash *) ObjData(ho);
   iter.object = ho;
   iter._current = 0;
-  iter.item = 0;
-  iter.key = 0;
-  iter._index = 0;		/* Index in hash table */
-  while ((iter._index < h->hashsize) && !h->hashtable[iter._index])
-    iter._index++;
-
-  if (iter._index >= h->hashsize) {
-    return iter;
-  }
-  iter._current = h->hashtable[iter._index];
-  iter.item = ((HashNode *) iter._current)->object;
-  iter.key = ((HashNode *) iter._current)->key;
-
-  /* Actually save the next slot in the hash.  This makes it possible to
-     delete the item being iterated over without trashing the universe */
-  iter._current = ((HashNode *) iter._current)->next;
-  return iter;
+  /* The position in the nodes array is used rather than a pointer to the node,
+     which makes it possible to delete the item being iterated over without
+     trashing the universe */
+  return hash_iter(iter, chain_next((Hash *) ObjData(ho), HASH_CHAIN_END, 0));
 }
 
 static DohIterator Hash_nextiter(DohIterator iter) {
   Hash *h = (Hash *) ObjData(iter.object);
-  if (!iter._current) {
-    iter._index++;
-    while ((iter._index < h->hashsize) && !h->hashtable[iter._index]) {
-      iter._index++;
-    }
-    if (iter._index >= h->hashsize) {
-      iter.item = 0;
-      iter.key = 0;
-      iter._current = 0;
-      return iter;
-    }
-    iter._current = h->hashtable[iter._index];
-  }
-  iter.key = ((HashNode *) iter._current)->key;
-  iter.item = ((HashNode *) iter._current)->object;
-
-  /* Store the next node to iterator on */
-  iter._current = ((HashNode *) iter._current)->next;
-  return iter;
+  HashNode *n = &h->nodes[iter._index];
+  return hash_iter(iter, chain_next(h, n->chainnext, n->chainval % h->chainsize + 1));
 }
 
 /* -----------------------------------------------------------------------------
@@ -419,28 +616,21 @@ static DOH *Hash_str(DOH *ho) {
   if (expanded >= max_expand) {
     /* replace each hash attribute with a '.' */
     Printf(s, "Hash(%p) {", ho);
-    for (i = 0; i < h->hashsize; i++) {
-      n = h->hashtable[i];
-      while (n) {
-	Putc('.', s);
-	n = n->next;
-      }
+    for (i = 0; i < h->nitems; i++) {
+      Putc('.', s);
     }
     Putc('}', s);
     return s;
   }
   ObjSetMark(ho, 1);
   Printf(s, "Hash(%p) {\n", ho);
-  for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      for (j = 0; j < expanded + 1; j++)
-	Printf(s, tab);
-      expanded += 1;
-      Printf(s, "'%s' : %s, \n", n->key, n->object);
-      expanded -= 1;
-      n = n->next;
-    }
+  for (i = chain_next(h, HASH_CHAIN_END, 0); i != HASH_CHAIN_END; i = chain_next(h, n->chainnext, n->chainval % h->chainsize + 1)) {
+    n = &h->nodes[i];
+    for (j = 0; j < expanded + 1; j++)
+      Printf(s, tab);
+    expanded += 1;
+    Printf(s, "'%s' : %s, \n", n->key, n->object);
+    expanded -= 1;
   }
   for (j = 0; j < expanded; j++)
     Printf(s, tab);
@@ -473,25 +663,25 @@ static DOH *CopyHash(DOH *ho) {
 
   int i;
   h = (Hash *) ObjData(ho);
-  nh = (Hash *) DohMalloc(sizeof(Hash));
-  nh->hashsize = h->hashsize;
-  nh->hashtable = (HashNode **) DohMalloc(nh->hashsize * sizeof(HashNode *));
-  for (i = 0; i < nh->hashsize; i++) {
-    nh->hashtable[i] = 0;
-  }
+  nh = (Hash *) DohSlabMalloc(sizeof(Hash));
+  nh->index = 0;
+  nh->indexsize = 0;
+  nh->nodes = 0;
+  nh->nodessize = 0;
+  nh->nnodes = 0;
   nh->nitems = 0;
+  /* Same number of iteration buckets, so that the copy iterates in the same order */
+  nh->chains = 0;
+  nh->chainsize = h->chainsize;
   nh->line = h->line;
   nh->file = h->file;
   if (nh->file)
     Incref(nh->file);
 
   nho = DohObjMalloc(&DohHashType, nh);
-  for (i = 0; i < h->hashsize; i++) {
-    n = h->hashtable[i];
-    while (n) {
-      Hash_setattr(nho, n->key, n->object);
-      n = n->next;
-    }
+  for (i = chain_next(h, HASH_CHAIN_END, 0); i != HASH_CHAIN_END; i = chain_next(h, n->chainnext, n->chainval % h->chainsize + 1)) {
+    n = &h->nodes[i];
+    Hash_setattr(nho, n->key, n->object);
   }
   return nho;
 }
@@ -572,14 +762,16 @@ DohObjInfo DohHashType = {
 
 DOH *DohNewHash(void) {
   Hash *h;
-  int i;
-  h = (Hash *) DohMalloc(sizeof(Hash));
-  h->hashsize = HASH_INIT_SIZE;
-  h->hashtable = (HashNode **) DohMalloc(h->hashsize * sizeof(HashNode *));
-  for (i = 0; i < h->hashsize; i++) {
-    h->hashtable[i] = 0;
-  }
+  h = (Hash *) DohSlabMalloc(sizeof(Hash));
+  /* The index and nodes are allocated when the first item is added */
+  h->index = 0;
+  h->indexsize = 0;
+  h->nodes = 0;
+  h->nodessize = 0;
+  h->nnodes = 0;
   h->nitems = 0;
+  h->chains = 0;
+  h->chainsize = HASH_CHAIN_INIT_SIZE;
   h->file = 0;
   h->line = 0;
   return DohObjMalloc(&DohHashType, h);
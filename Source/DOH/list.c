@@ -26,7 +26,7 @@ extern DohObjInfo DohListType;
 /* Doubles amount of memory in a list */
 static
 void more(List *l) {
-  l->items = (void **) DohRealloc(l->items, l->maxitems * 2 * sizeof(void *));
+  l->items = (void **) DohSlabRealloc(l->items, l->maxitems * sizeof(void *), l->maxitems * 2 * sizeof(void *));
   assert(l->items);
   l->maxitems *= 2;
 }
@@ -40,10 +40,10 @@ static DOH *CopyList(DOH *lo) {
   List *l, *nl;
   int i;
   l = (List *) ObjData(lo);
-  nl = (List *) DohMalloc(sizeof(List));
+  nl = (List *) DohSlabMalloc(sizeof(List));
   nl->nitems = l->nitems;
   nl->maxitems = l->maxitems;
-  nl->items = (void **) DohMalloc(l->maxitems * sizeof(void *));
+  nl->items = (void **) DohSlabMalloc(l->maxitems * sizeof(void *));
   for (i = 0; i < l->nitems; i++) {
     nl->items[i] = l->items[i];
     Incref(nl->items[i]);
@@ -66,8 +66,8 @@ static void DelList(DOH *lo) {
   int i;
   for (i = 0; i < l->nitems; i++)
     Delete(l->items[i]);
-  DohFree(l->items);
-  DohFree(l);
+  DohSlabFree(l->items, l->maxitems * sizeof(void *));
+  DohSlabFree(l, sizeof(List));
 }
 
 /* -----------------------------------------------------------------------------
@@ -348,10 +348,10 @@ DohObjInfo DohListType = {
 DOH *DohNewList(void) {
   List *l;
   int i;
-  l = (List *) DohMalloc(sizeof(List));
+  l = (List *) DohSlabMalloc(sizeof(List));
   l->nitems = 0;
   l->maxitems = MAXLISTITEMS;
-  l->items = (void **) DohMalloc(l->maxitems * sizeof(void *));
+  l->items = (void **) DohSlabMalloc(l->maxitems * sizeof(void *));
   for (i = 0; i < MAXLISTITEMS; i++) {
     l->items[i] = 0;
   }
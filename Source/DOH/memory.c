@@ -18,6 +18,17 @@
 #define DOH_POOL_SIZE         16384
 #endif
 
+#ifndef DOH_SLAB_CHUNK_SIZE
+#define DOH_SLAB_CHUNK_SIZE   262144
+#endif
+
+/* Size classes for the slab allocator.  Blocks up to DOH_SLAB_MAX bytes are
+   rounded up to a multiple of DOH_SLAB_ALIGN and carved out of large chunks. */
+#define DOH_SLAB_ALIGN        16
+#define DOH_SLAB_MAX          1024
+#define DOH_SLAB_NCLASSES     (DOH_SLAB_MAX / DOH_SLAB_ALIGN)
+#define DOH_SLAB_CLASS(size)  ((int)(((size) + DOH_SLAB_ALIGN - 1) / DOH_SLAB_ALIGN) - 1)
+
 /* Checks stale DOH object use - will use a lot more memory as pool memory is not re-used. */
 /*
 #define DOH_DEBUG_MEMORY_POOLS
@@ -41,12 +52,34 @@ static DohBase *FreeList = 0;	/* List of free objects */
 static Pool *Pools = 0;
 static int pools_initialized = 0;
 
+typedef struct SlabBlock {
+  struct SlabBlock *next;	/* Next free block of the same size class */
+} SlabBlock;
+
+typedef struct SlabChunk {
+  struct SlabChunk *next;	/* Next chunk */
+  double align;			/* Keep the first block suitably aligned */
+} SlabChunk;
+
+static SlabBlock *SlabFreeList[DOH_SLAB_NCLASSES];	/* Free blocks for each size class */
+static int SlabInUse[DOH_SLAB_NCLASSES];	/* Blocks in use for each size class */
+static SlabChunk *SlabChunks = 0;
+static char *slab_current = 0;	/* Next unused byte in the current chunk */
+static size_t slab_avail = 0;	/* Unused bytes left in the current chunk */
+static int slab_nchunks = 0;
+
+/* Pools sorted by address so that DohCheck() can use a binary search */
+static Pool **PoolIndex = 0;
+static int npools = 0;
+static int maxpools = 0;
+
 /* ----------------------------------------------------------------------
  * CreatePool() - Create a new memory pool 
  * ---------------------------------------------------------------------- */
 
 static void CreatePool() {
   Pool *p = 0;
+  int i;
   p = (Pool *) DohMalloc(sizeof(Pool));
   assert(p);
   p->ptr = (DohBase *) DohMalloc(sizeof(DohBase) * PoolSize);
@@ -59,6 +92,20 @@ static void CreatePool() {
   p->pend = p->pbeg + p->blen;
   p->next = Pools;
   Pools = p;
+
+  /* Insert into the sorted pool index */
+  if (npools == maxpools) {
+    maxpools = maxpools ? 2 * maxpools : 16;
+    PoolIndex = (Pool **) DohRealloc(PoolIndex, maxpools * sizeof(Pool *));
+    assert(PoolIndex);
+  }
+  i = npools;
+  while ((i > 0) && (PoolIndex[i - 1]->pbeg > p->pbeg)) {
+    PoolIndex[i] = PoolIndex[i - 1];
+    i--;
+  }
+  PoolIndex[i] = p;
+  npools++;
 }
 
 /* ----------------------------------------------------------------------
@@ -81,10 +128,17 @@ static void InitPools() {
  * ---------------------------------------------------------------------- */
 
 int DohCheck(const DOH *ptr) {
-  Pool *p = Pools;
-  char *cptr = (char *) ptr;
-  while (p) {
-    if ((cptr >= p->pbeg) && (cptr < p->pend)) {
+  const char *cptr = (const char *) ptr;
+  int lo = 0;
+  int hi = npools - 1;
+  while (lo <= hi) {
+    int mid = (lo + hi) / 2;
+    Pool *p = PoolIndex[mid];
+    if (cptr < p->pbeg) {
+      hi = mid - 1;
+    } else if (cptr >= p->pend) {
+      lo = mid + 1;
+    } else {
 #ifdef DOH_DEBUG_MEMORY_POOLS
       DohBase *b = (DohBase *) ptr;
       int DOH_object_already_deleted = b->type == 0;
@@ -92,10 +146,6 @@ int DohCheck(const DOH *ptr) {
 #endif
       return 1;
     }
-    /*
-       pptr = (char *) p->ptr;
-       if ((cptr >= pptr) && (cptr < (pptr+(p->current*sizeof(DohBase))))) return 1; */
-    p = p->next;
   }
   return 0;
 }
@@ -164,6 +214,101 @@ void DohObjFree(DOH *ptr) {
   }
 }
 
+/* ----------------------------------------------------------------------
+ * CreateSlabChunk() - Create a new chunk to carve slab blocks from
+ * ---------------------------------------------------------------------- */
+
+static void CreateSlabChunk() {
+  SlabChunk *c = (SlabChunk *) DohMalloc(DOH_SLAB_CHUNK_SIZE);
+  size_t header = ((sizeof(SlabChunk) + DOH_SLAB_ALIGN - 1) / DOH_SLAB_ALIGN) * DOH_SLAB_ALIGN;
+  assert(c);
+  c->next = SlabChunks;
+  SlabChunks = c;
+  slab_current = ((char *) c) + header;
+  slab_avail = DOH_SLAB_CHUNK_SIZE - header;
+  slab_nchunks++;
+}
+
+/* ----------------------------------------------------------------------
+ * DohSlabMalloc()
+ *
+ * Allocate size bytes for an object payload or buffer.  Small blocks come
+ * from per size class free lists which are refilled by bump allocation from
+ * large chunks, avoiding the time and space overhead of malloc for the many
+ * small objects in a parse tree.  Larger blocks use DohMalloc.  The caller
+ * must pass the same size to DohSlabFree() and DohSlabRealloc().
+ * ---------------------------------------------------------------------- */
+
+void *DohSlabMalloc(size_t size) {
+  void *ptr;
+#ifndef DOH_DEBUG_MEMORY_POOLS
+  if (size <= DOH_SLAB_MAX) {
+    int sc = DOH_SLAB_CLASS(size ? size : 1);
+    SlabBlock *b = SlabFreeList[sc];
+    if (b) {
+      SlabFreeList[sc] = b->next;
+    } else {
+      size_t bsize = (sc + 1) * DOH_SLAB_ALIGN;
+      if (slab_avail < bsize)
+	CreateSlabChunk();
+      b = (SlabBlock *) slab_current;
+      slab_current += bsize;
+      slab_avail -= bsize;
+    }
+    SlabInUse[sc]++;
+    return (void *) b;
+  }
+#endif
+  ptr = DohMalloc(size);
+  assert(ptr);
+  return ptr;
+}
+
+/* ----------------------------------------------------------------------
+ * DohSlabFree() - Release a block allocated with DohSlabMalloc()
+ * ---------------------------------------------------------------------- */
+
+void DohSlabFree(void *ptr, size_t size) {
+  if (!ptr)
+    return;
+#ifndef DOH_DEBUG_MEMORY_POOLS
+  if (size <= DOH_SLAB_MAX) {
+    int sc = DOH_SLAB_CLASS(size ? size : 1);
+    SlabBlock *b = (SlabBlock *) ptr;
+    b->next = SlabFreeList[sc];
+    SlabFreeList[sc] = b;
+    SlabInUse[sc]--;
+    return;
+  }
+#endif
+  DohFree(ptr);
+}
+
+/* ----------------------------------------------------------------------
+ * DohSlabRealloc() - Resize a block allocated with DohSlabMalloc()
+ * ---------------------------------------------------------------------- */
+
+void *DohSlabRealloc(void *ptr, size_t oldsize, size_t newsize) {
+  void *newptr;
+  if (!ptr)
+    return DohSlabMalloc(newsize);
+#ifndef DOH_DEBUG_MEMORY_POOLS
+  if (oldsize <= DOH_SLAB_MAX || newsize <= DOH_SLAB_MAX) {
+    if (oldsize <= DOH_SLAB_MAX && newsize <= DOH_SLAB_MAX && DOH_SLAB_CLASS(oldsize ? oldsize : 1) == DOH_SLAB_CLASS(newsize ? newsize : 1))
+      return ptr;
+    newptr = DohSlabMalloc(newsize);
+    memcpy(newptr, ptr, oldsize < newsize ? oldsize : newsize);
+    DohSlabFree(ptr, oldsize);
+    return newptr;
+  }
+#else
+  (void)oldsize;
+#endif
+  newptr = DohRealloc(ptr, newsize);
+  assert(newptr);
+  return newptr;
+}
+
 /* ----------------------------------------------------------------------
  * DohMemoryDebug()
  *
@@ -213,6 +358,19 @@ void DohMemoryDebug(void) {
   }
   printf("\n    Total:          size = %10d, used = %10d, free = %10d\n", totsize, totused, totfree);
 
+  printf("\nSlabs:\n");
+  {
+    int i;
+    int totblocks = 0;
+    for (i = 0; i < DOH_SLAB_NCLASSES; i++) {
+      if (SlabInUse[i]) {
+	printf("    Size %4d: used = %10d\n", (i + 1) * DOH_SLAB_ALIGN, SlabInUse[i]);
+	totblocks += SlabInUse[i];
+      }
+    }
+    printf("\n    Total:          chunks = %8d, bytes = %10d, used blocks = %10d\n", slab_nchunks, slab_nchunks * DOH_SLAB_CHUNK_SIZE, totblocks);
+  }
+
   printf("\nObject types\n");
   printf("    Strings   : %d\n", numstring);
   printf("    Lists     : %d\n", numlist);
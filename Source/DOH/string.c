@@ -66,16 +66,16 @@ static int String_dump(DOH *so, DOH *out) {
 static DOH *CopyString(DOH *so) {
   String *str;
   String *s = (String *) ObjData(so);
-  str = (String *) DohMalloc(sizeof(String));
+  str = (String *) DohSlabMalloc(sizeof(String));
   str->hashkey = s->hashkey;
   str->sp = s->sp;
   str->line = s->line;
   str->file = s->file;
   if (str->file)
     Incref(str->file);
-  str->str = (char *) DohMalloc(s->len + 1);
+  str->str = (char *) DohSlabMalloc(s->len + 1);
   memcpy(str->str, s->str, s->len);
-  str->maxsize = s->len;
+  str->maxsize = s->len + 1;
   str->len = s->len;
   str->str[str->len] = 0;
 
@@ -88,8 +88,8 @@ static DOH *CopyString(DOH *so) {
 
 static void DelString(DOH *so) {
   String *s = (String *) ObjData(so);
-  DohFree(s->str);
-  DohFree(s);
+  DohSlabFree(s->str, s->maxsize);
+  DohSlabFree(s, sizeof(String));
 }
 
 /* -----------------------------------------------------------------------------
@@ -171,33 +171,70 @@ static int String_equal(DOH *so1, DOH *so2) {
   }
 }
 
+/* -----------------------------------------------------------------------------
+ * DohStringHashval() - Compute the hash value of len characters of c
+ *
+ * The whole string is hashed as long mangled C++ type names often only differ
+ * near the end. The hash function is based on MurmurHash3 (x86, 32-bit) with
+ * four bytes mixed in at a time.  This is also used by the Hash key interning
+ * table so that interned keys and Strings hash identically.
+ * ----------------------------------------------------------------------------- */
+
+#define HASH_ROTL32(x, r) (((x) << (r)) | ((x) >> (32 - (r))))
+
+int DohStringHashval(const char *str, int length) {
+  const unsigned char *c = (const unsigned char *) str;
+  unsigned int len = (unsigned int) length;
+  unsigned int h = 0x9747b28c;
+  unsigned int k;
+  unsigned int i;
+  const unsigned int c1 = 0xcc9e2d51;
+  const unsigned int c2 = 0x1b873593;
+
+  for (i = len >> 2; i; --i) {
+    k = (unsigned int) c[0] | ((unsigned int) c[1] << 8) | ((unsigned int) c[2] << 16) | ((unsigned int) c[3] << 24);
+    c += 4;
+    k *= c1;
+    k = HASH_ROTL32(k, 15) & 0xffffffff;
+    k *= c2;
+    h ^= k;
+    h = HASH_ROTL32(h, 13) & 0xffffffff;
+    h = h * 5 + 0xe6546b64;
+  }
+  k = 0;
+  switch (len & 3) {
+  case 3:
+    k ^= (unsigned int) c[2] << 16;
+    /* FALLTHRU */
+  case 2:
+    k ^= (unsigned int) c[1] << 8;
+    /* FALLTHRU */
+  case 1:
+    k ^= (unsigned int) c[0];
+    k *= c1;
+    k = HASH_ROTL32(k, 15) & 0xffffffff;
+    k *= c2;
+    h ^= k;
+  }
+  h ^= len;
+  h ^= (h & 0xffffffff) >> 16;
+  h *= 0x85ebca6b;
+  h ^= (h & 0xffffffff) >> 13;
+  h *= 0xc2b2ae35;
+  h ^= (h & 0xffffffff) >> 16;
+
+  return (int) (h & 0x7fffffff);
+}
+
 /* -----------------------------------------------------------------------------
  * String_hash() - Compute string hash value
  * ----------------------------------------------------------------------------- */
 
 static int String_hash(DOH *so) {
   String *s = (String *) ObjData(so);
-  if (s->hashkey >= 0) {
-    return s->hashkey;
-  } else {
-    char *c = s->str;
-    unsigned int len = s->len > 50 ? 50 : s->len;
-    unsigned int h = 0;
-    unsigned int mlen = len >> 2;
-    unsigned int i = mlen;
-    for (; i; --i) {
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-      h = (h << 5) + *(c++);
-    }
-    for (i = len - (mlen << 2); i; --i) {
-      h = (h << 5) + *(c++);
-    }
-    h &= 0x7fffffff;
-    s->hashkey = (int)h;
-    return h;
-  }
+  if (s->hashkey < 0)
+    s->hashkey = DohStringHashval(s->str, s->len);
+  return s->hashkey;
 }
 
 /* -----------------------------------------------------------------------------
@@ -228,7 +265,7 @@ static void DohString_append(DOH *so, const DOHString_or_char *str) {
     newmaxsize = 2 * s->maxsize;
     if (newlen >= newmaxsize - 1)
       newmaxsize = newlen + 1;
-    s->str = (char *) DohRealloc(s->str, newmaxsize);
+    s->str = (char *) DohSlabRealloc(s->str, s->maxsize, newmaxsize);
     assert(s->str);
     s->maxsize = newmaxsize;
   }
@@ -295,7 +332,7 @@ static int String_insert(DOH *so, int pos, DOH *str) {
   /* See if there is room to insert the new data */
   while (s->maxsize <= s->len + len) {
     int newsize = 2 * s->maxsize;
-    s->str = (char *) DohRealloc(s->str, newsize);
+    s->str = (char *) DohSlabRealloc(s->str, s->maxsize, newsize);
     assert(s->str);
     s->maxsize = newsize;
   }
@@ -423,7 +460,7 @@ static int String_write(DOH *so, const void *buffer, int len) {
     s->sp = s->len;
   newlen = s->sp + len + 1;
   if (newlen > s->maxsize) {
-    s->str = (char *) DohRealloc(s->str, newlen);
+    s->str = (char *) DohSlabRealloc(s->str, s->maxsize, newlen);
     assert(s->str);
     s->maxsize = newlen;
     s->len = s->sp + len;
@@ -516,7 +553,7 @@ static int String_putc(DOH *so, int ch) {
     char *tc = s->str;
     if (len > (maxsize - 2)) {
       maxsize *= 2;
-      tc = (char *) DohRealloc(tc, maxsize);
+      tc = (char *) DohSlabRealloc(tc, s->maxsize, maxsize);
       assert(tc);
       s->maxsize = (int) maxsize;
       s->str = tc;
@@ -837,7 +874,7 @@ static int replace_simple(String *str, char *token, char *rep, int flags, int co
     while ((str->len + expand) >= newsize)
       newsize *= 2;
 
-    ns = (char *) DohMalloc(newsize);
+    ns = (char *) DohSlabMalloc(newsize);
     assert(ns);
     t = ns;
     s = first;
@@ -889,8 +926,8 @@ static int replace_simple(String *str, char *token, char *rep, int flags, int co
       str->sp += expand;
     str->len += expand;
     str->str[str->len] = 0;
+    DohSlabFree(c, str->maxsize);
     str->maxsize = newsize;
-    DohFree(c);
     return rcount;
   }
 }
@@ -1042,7 +1079,7 @@ DOHString *DohNewString(const DOHString_or_char *so) {
     l = s ? (int) strlen(s) : 0;
   }
 
-  str = (String *) DohMalloc(sizeof(String));
+  str = (String *) DohSlabMalloc(sizeof(String));
   str->hashkey = hashkey;
   str->sp = 0;
   str->line = 1;
@@ -1052,7 +1089,7 @@ DOHString *DohNewString(const DOHString_or_char *so) {
     if ((l + 1) > max)
       max = l + 1;
   }
-  str->str = (char *) DohMalloc(max);
+  str->str = (char *) DohSlabMalloc(max);
   str->maxsize = max;
   if (s) {
     strcpy(str->str, s);
@@ -1072,12 +1109,12 @@ DOHString *DohNewString(const DOHString_or_char *so) {
 
 DOHString *DohNewStringEmpty(void) {
   int max = INIT_MAXSIZE;
-  String *str = (String *) DohMalloc(sizeof(String));
-  str->hashkey = 0;
+  String *str = (String *) DohSlabMalloc(sizeof(String));
+  str->hashkey = -1;
   str->sp = 0;
   str->line = 1;
   str->file = 0;
-  str->str = (char *) DohMalloc(max);
+  str->str = (char *) DohSlabMalloc(max);
   str->maxsize = max;
   str->str[0] = 0;
   str->len = 0;
@@ -1098,7 +1135,7 @@ DOHString *DohNewStringWithSize(const DOHString_or_char *so, int len) {
     s = (char *) so;
   }
 
-  str = (String *) DohMalloc(sizeof(String));
+  str = (String *) DohSlabMalloc(sizeof(String));
   str->hashkey = -1;
   str->sp = 0;
   str->line = 1;
@@ -1109,7 +1146,7 @@ DOHString *DohNewStringWithSize(const DOHString_or_char *so, int len) {
     if ((l + 1) > max)
       max = l + 1;
   }
-  str->str = (char *) DohMalloc(max);
+  str->str = (char *) DohSlabMalloc(max);
   str->maxsize = max;
   if (s) {
     strncpy(str->str, s, len);
@@ -29,7 +29,7 @@ static void Void_delete(DOH *vo) {
   VoidObj *v = (VoidObj *) ObjData(vo);
   if (v->del)
     (*v->del) (v->ptr);
-  DohFree(v);
+  DohSlabFree(v, sizeof(VoidObj));
 }
 
 /* -----------------------------------------------------------------------------
@@ -89,7 +89,7 @@ static DohObjInfo DohVoidType = {
 
 DOH *DohNewVoid(void *obj, void (*del) (void *)) {
   VoidObj *v;
-  v = (VoidObj *) DohMalloc(sizeof(VoidObj));
+  v = (VoidObj *) DohSlabMalloc(sizeof(VoidObj));
   v->ptr = obj;
   v->del = del;
   return DohObjMalloc(&DohVoidType, v);
@@ -311,6 +311,8 @@
 #define WARN_CSHARP_EXCODE                    844
 #define WARN_CSHARP_CANTHROW                  845
 #define WARN_CSHARP_NO_DIRECTORCONNECT_ATTR   846
+#define WARN_CSHARP_BLITTABLE_MEMBER          847
+#define WARN_CSHARP_SUPPRESSGCTRANSITION      848
 
 /* please leave 830-849 free for C# */
 
@@ -815,6 +815,7 @@ public:
       if (imtypeout)
 	tm = imtypeout;
       Printf(im_return_type, "%s", tm);
+      substituteClassname(t, im_return_type);
       im_outattributes = Getattr(n, "tmap:imtype:outattributes");
     } else {
       Swig_warning(WARN_CSHARP_TYPEMAP_CSTYPE_UNDEF, input_file, line_number, "No imtype typemap defined for %s\n", SwigType_str(t, 0));
@@ -848,6 +849,9 @@ public:
 
     Printv(imclass_class_code, "\n  [global::System.Runtime.InteropServices.DllImport(\"", dllimport, "\", EntryPoint=\"", wname, "\")]\n", NIL);
 
+    // Position for the SuppressGCTransition attribute, only known to be safe once the wrapper code is complete
+    int suppressgctransition_pos = GetFlag(n, "feature:cs:suppressgctransition") ? Len(imclass_class_code) : -1;
+
     if (im_outattributes)
       Printf(imclass_class_code, "  %s\n", im_outattributes);
 
@@ -884,6 +888,7 @@ public:
       if ((tm = Getattr(p, "tmap:imtype"))) {
 	const String *inattributes = Getattr(p, "tmap:imtype:inattributes");
 	Printf(im_param_type, "%s%s", inattributes ? inattributes : empty_string, tm);
+	substituteClassname(pt, im_param_type);
       } else {
 	Swig_warning(WARN_CSHARP_TYPEMAP_CSTYPE_UNDEF, input_file, line_number, "No imtype typemap defined for %s\n", SwigType_str(pt, 0));
       }
@@ -1072,6 +1077,19 @@ public:
 		       "Unmanaged code contains a call to a SWIG_CSharpSetPendingException method and C# code does not handle pending exceptions via the canthrow attribute.\n");
 	}
       }
+
+      // The GC transition can only be suppressed if the unmanaged code cannot call back into managed code,
+      // which the wrappers do to set pending exceptions and to create strings
+      if (suppressgctransition_pos >= 0) {
+	if (Getattr(n, "csharp:canthrow") || Strstr(f->code, "SWIG_CSharpSetPendingException") || Strstr(f->code, "SWIG_exception") ||
+	    Strstr(f->code, "SWIG_csharp_string_callback") || Strstr(f->code, "SWIG_csharp_wstring_callback")) {
+	  Swig_warning(WARN_CSHARP_SUPPRESSGCTRANSITION, input_file, line_number,
+		       "The suppressgctransition feature is ignored for %s as the unmanaged code can call back into managed code.\n", Swig_name_decl(n));
+	} else {
+	  // The attribute only exists in .NET 5 and later
+	  Insert(imclass_class_code, suppressgctransition_pos, "#if NET5_0_OR_GREATER\n  [global::System.Runtime.InteropServices.SuppressGCTransition]\n#endif\n");
+	}
+      }
     }
 
     if (!(proxy_flag && is_wrapping_class()) && !enum_constant_flag) {
@@ -2080,11 +2098,219 @@ public:
     }
   }
 
+  /* ----------------------------------------------------------------------
+   * isBlittableValue()
+   *
+   * True if the intermediary C type ctype for the type t is a struct wrapped
+   * with the cs:blittable feature, so the variable cannot be initialised to 0.
+   * ---------------------------------------------------------------------- */
+
+  bool isBlittableValue(SwigType *t, const String *ctype) {
+    Node *cls = classLookup(t);
+    return cls && GetFlag(cls, "feature:cs:blittable") && !Strchr(ctype, '*');
+  }
+
+  /* ----------------------------------------------------------------------
+   * blittableFieldSize()
+   *
+   * Size in bytes of a C# blittable primitive type, or 0 if the type is not
+   * one of the primitive types with the same size and alignment as in C.
+   * ---------------------------------------------------------------------- */
+
+  static int blittableFieldSize(const String *cstype) {
+    static const char *types[] = { "sbyte", "byte", "short", "ushort", "int", "uint", "long", "ulong", "float", "double" };
+    static const int sizes[] = { 1, 1, 2, 2, 4, 4, 8, 8, 4, 8 };
+    for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++) {
+      if (Strcmp(cstype, types[i]) == 0)
+	return sizes[i];
+    }
+    return 0;
+  }
+
+  /* ----------------------------------------------------------------------
+   * blittableStructHandler()
+   *
+   * A class with the cs:blittable feature is wrapped as a C# struct with
+   * sequential layout containing the same data members as the C/C++ class,
+   * instead of as a proxy class. The struct is passed by value across the
+   * P/Invoke boundary, so no wrappers are generated for the class members.
+   * The layout is checked when compiling the C/C++ wrapper code.
+   * ---------------------------------------------------------------------- */
+
+  int blittableStructHandler(Node *n) {
+    String *nspace = getNSpace();
+    String *symname = Getattr(n, "sym:name");
+    String *c_classname = SwigType_str(Getattr(n, "classtypeobj"), 0);
+    // The %csharp_blittable typemaps for a C 'typedef struct' use the typedef name
+    SwigType *typemap_lookup_type = Getattr(n, "tdname") ? Getattr(n, "tdname") : Getattr(n, "classtypeobj");
+
+    if (Getattr(n, "nested:outer") && !GetFlag(n, "feature:flatnested")) {
+      Swig_error(Getfile(n), Getline(n), "The blittable feature is not supported for nested class %s.\n", SwigType_namestr(Getattr(n, "name")));
+      return SWIG_ERROR;
+    }
+    if (Cmp(Getattr(n, "kind"), "union") == 0 || Getattr(n, "bases")) {
+      Swig_error(Getfile(n), Getline(n), "The blittable feature is not supported for %s as it is a union or derived class.\n", SwigType_namestr(Getattr(n, "name")));
+      return SWIG_ERROR;
+    }
+    if (!addSymbol(symname, n, nspace))
+      return SWIG_ERROR;
+
+    String *fields = NewString("");
+    String *checks = NewString("");
+    int offset = 0;
+    int alignment = 1;
+    bool layout_ok = true;
+
+    // Class members including those added by %extend
+    List *members = NewList();
+    for (Node *c = firstChild(n); c; c = nextSibling(c)) {
+      if (Cmp(nodeType(c), "extend") == 0) {
+	for (Node *e = firstChild(c); e; e = nextSibling(e))
+	  Append(members, e);
+      } else {
+	Append(members, c);
+      }
+    }
+
+    for (Iterator it = First(members); it.item; it = Next(it)) {
+      Node *c = it.item;
+      if (Cmp(Getattr(c, "storage"), "virtual") == 0) {
+	Swig_error(Getfile(c), Getline(c), "The blittable feature is not supported for polymorphic class %s.\n", SwigType_namestr(Getattr(n, "name")));
+	layout_ok = false;
+	continue;
+      }
+      if (Cmp(nodeType(c), "cdecl") != 0 || Swig_storage_isstatic(c) || Cmp(Getattr(c, "storage"), "typedef") == 0)
+	continue;
+      if (Cmp(Getattr(c, "kind"), "variable") != 0 || GetFlag(c, "feature:extend")) {
+	if (is_public(c) && !GetFlag(c, "feature:ignore"))
+	  Swig_warning(WARN_CSHARP_BLITTABLE_MEMBER, Getfile(c), Getline(c), "Member %s of blittable struct %s ignored, only data members are wrapped.\n",
+		       Getattr(c, "name"), symname);
+	continue;
+      }
+
+      String *name = Getattr(c, "name");
+      SwigType *type = Getattr(c, "type");
+      SwigType *resolved = SwigType_typedef_resolve_all(type);
+      SwigType *stripped = SwigType_strip_qualifiers(resolved);
+      int size = 0;
+      int align = 0;
+      String *cstype = 0;
+
+      if (Getattr(c, "bitfield") || SwigType_isarray(stripped) || SwigType_ispointer(stripped) || SwigType_isreference(stripped)) {
+	// No blittable C# equivalent
+      } else if (Node *cls = classLookup(stripped)) {
+	if (GetFlag(cls, "feature:cs:blittable") && Getattr(cls, "csharp:blittable:size")) {
+	  size = atoi(Char(Getattr(cls, "csharp:blittable:size")));
+	  align = atoi(Char(Getattr(cls, "csharp:blittable:align")));
+	}
+      } else {
+	String *tm = Swig_typemap_lookup("cstype", c, "", 0);
+	if (tm) {
+	  cstype = Copy(tm);
+	  substituteClassname(type, cstype);
+	  size = blittableFieldSize(cstype);
+	  if (!size && SwigType_isenum(stripped)) {
+	    // Proper C# enums have an int underlying type, typesafe enums are classes
+	    Node *enum_node = enumLookup(stripped);
+	    if (enum_node && Cmp(Getattr(enum_node, "feature:cs:enum"), "typesafe") != 0)
+	      size = 4;
+	  }
+	  if (size && is_public(c))
+	    Printf(checks, " &&\n  sizeof(((%s *)0)->%s) == %d", c_classname, name, size);
+	  align = size;
+	}
+      }
+
+      if (!size) {
+	Swig_error(Getfile(c), Getline(c), "Member %s of type %s in blittable struct %s does not have a blittable C# type.\n", name, SwigType_str(type, 0), symname);
+	layout_ok = false;
+      } else {
+	if (!cstype) {
+	  cstype = Copy(Swig_typemap_lookup("cstype", c, "", 0));
+	  substituteClassname(type, cstype);
+	}
+	String *field_name = Getattr(c, "sym:name");
+	bool is_visible = is_public(c) && field_name && !GetFlag(c, "feature:ignore");
+	const String *csattributes = Getattr(c, "feature:cs:attributes");
+	if (csattributes && is_visible)
+	  Printf(fields, "  %s\n", csattributes);
+	Printf(fields, "  %s %s %s;\n", is_visible ? "public" : "private", cstype, is_visible ? field_name : name);
+	offset = (offset + align - 1) / align * align + size;
+	if (align > alignment)
+	  alignment = align;
+      }
+      Delete(cstype);
+      Delete(stripped);
+      Delete(resolved);
+    }
+
+    if (layout_ok) {
+      int size = (offset + alignment - 1) / alignment * alignment;
+      Setattr(n, "csharp:blittable:size", NewStringf("%d", size));
+      Setattr(n, "csharp:blittable:align", NewStringf("%d", alignment));
+      if (!ImportMode) {
+	String *mangled = Swig_name_mangle(c_classname);
+	Printf(f_wrappers, "\n/* Check that the layout of %s matches the C# struct %s */\n", c_classname, symname);
+	Printf(f_wrappers, "typedef char SWIG_csharp_blittable_%s[(sizeof(%s) == %d%s) ? 1 : -1];\n", mangled, c_classname, size, checks);
+	Delete(mangled);
+      }
+    }
+
+    if (!ImportMode) {
+      String *struct_code = NewString("");
+      String *output_directory = outputDirectory(nspace);
+      File *f_struct = getOutputFile(output_directory, symname);
+      addOpenNamespace(nspace, f_struct);
+
+      Printv(struct_code, typemapLookup(n, "csimports", typemap_lookup_type, WARN_NONE), "\n", NIL);
+      const String *csattributes = typemapLookup(n, "csattributes", typemap_lookup_type, WARN_NONE);
+      if (csattributes && *Char(csattributes))
+	Printf(struct_code, "%s\n", csattributes);
+      Printv(struct_code, "[global::System.Runtime.InteropServices.StructLayout(global::System.Runtime.InteropServices.LayoutKind.Sequential)]\n",
+	     typemapLookup(n, "csclassmodifiers", typemap_lookup_type, WARN_CSHARP_TYPEMAP_CLASSMOD_UNDEF), " $csclassname {\n", fields,
+	     typemapLookup(n, "cscode", typemap_lookup_type, WARN_NONE), NIL);
+
+      // %proxycode in the class body
+      for (Iterator it = First(members); it.item; it = Next(it)) {
+	Node *c = it.item;
+	if (Cmp(nodeType(c), "insert") == 0 && Cmp(Getattr(c, "section"), "proxycode") == 0) {
+	  String *code = Copy(Getattr(c, "code"));
+	  Swig_typemap_replace_embedded_typemap(code, c);
+	  int code_offset = Len(code) > 0 && *Char(code) == '\n' ? 1 : 0;
+	  Printv(struct_code, Char(code) + code_offset, "\n", NIL);
+	  Delete(code);
+	}
+      }
+      Printf(struct_code, "}\n");
+
+      Replaceall(struct_code, "$csclassname", symname);
+      Replaceall(struct_code, "$module", module_class_name);
+      Replaceall(struct_code, "$imclassname", full_imclass_name ? full_imclass_name : imclass_name);
+      Replaceall(struct_code, "$dllimport", dllimport);
+      Printv(f_struct, struct_code, NIL);
+
+      addCloseNamespace(nspace, f_struct);
+      if (f_struct != f_single_out)
+	Delete(f_struct);
+      Delete(output_directory);
+      Delete(struct_code);
+    }
+
+    Delete(members);
+    Delete(checks);
+    Delete(fields);
+    Delete(c_classname);
+    return layout_ok ? SWIG_OK : SWIG_ERROR;
+  }
+
   /* ----------------------------------------------------------------------
    * classHandler()
    * ---------------------------------------------------------------------- */
 
   virtual int classHandler(Node *n) {
+    if (proxy_flag && GetFlag(n, "feature:cs:blittable"))
+      return blittableStructHandler(n);
+
     String *nspace = getNSpace();
     File *f_proxy = NULL;
     File *f_interface = NULL;
@@ -3893,6 +4119,7 @@ public:
       String *imtypeout = Getattr(n, "tmap:imtype:out");	// the type in the imtype typemap's out attribute overrides the type in the typemap
       if (imtypeout)
 	tm = imtypeout;
+      substituteClassname(returntype, tm);
       const String *im_directoroutattributes = Getattr(n, "tmap:imtype:directoroutattributes");
       if (im_directoroutattributes) {
 	Printf(callback_def, "  %s\n", im_directoroutattributes);
@@ -3914,7 +4141,7 @@ public:
     if ((c_ret_type = Swig_typemap_lookup("ctype", n, "", 0))) {
       if (!is_void && !ignored_method) {
 	String *jretval_decl = NewStringf("%s jresult", c_ret_type);
-	Wrapper_add_localv(w, "jresult", jretval_decl, "= 0", NIL);
+	Wrapper_add_localv(w, "jresult", jretval_decl, isBlittableValue(returntype, c_ret_type) ? "" : "= 0", NIL);
 	Delete(jretval_decl);
       }
     } else {
@@ -3988,7 +4215,7 @@ public:
 	/* Add to local variables */
 	Printf(c_decl, "%s %s", c_param_type, arg);
 	if (!ignored_method)
-	  Wrapper_add_localv(w, arg, c_decl, (!(SwigType_ispointer(pt) || SwigType_isreference(pt)) ? "" : "= 0"), NIL);
+	  Wrapper_add_localv(w, arg, c_decl, (!(SwigType_ispointer(pt) || SwigType_isreference(pt)) || isBlittableValue(pt, c_param_type) ? "" : "= 0"), NIL);
 
 	/* Add input marshalling code */
 	if ((tm = Getattr(p, "tmap:directorin"))) {
@@ -4013,6 +4240,7 @@ public:
 	    String *imtypeout = Getattr(p, "tmap:imtype:out");	// the type in the imtype typemap's out attribute overrides the type in the typemap
 	    if (imtypeout)
 	      tm = imtypeout;
+	    substituteClassname(pt, tm);
             const String *im_directorinattributes = Getattr(p, "tmap:imtype:directorinattributes");
 
 	    String *din = Copy(Getattr(p, "tmap:csdirectorin"));
@@ -54,6 +54,13 @@ extern "C" {
   }
 }
 
+/* Call a Language handler, timing it for -profile */
+static int profile_end(const char *handler, int ret) {
+  Swig_profile_end(handler);
+  return ret;
+}
+#define PROFILE_HANDLER(handler, n) profile_end("handler:" #handler, (Swig_profile_begin("handler:" #handler), handler(n)))
+
 /* Some status variables used during parsing */
 static int InClass = 0; /* Parsing C++ or not */
 static String *ClassName = 0;	/* This is the real name of the current class */
@@ -372,6 +379,7 @@ Language::~Language() {
 int Language::emit_one(Node *n) {
   int ret;
   int oldext;
+  int profile = 1;
   if (!n)
     return SWIG_OK;
 
@@ -386,13 +394,24 @@ int Language::emit_one(Node *n) {
   line_number = Getline(n);
   input_file = Getfile(n);
 
+  /* Time the declarations for -profile, but not the nodes just containing them */
+  if (Swig_profile_enabled()) {
+    String *tag = nodeType(n);
+    if (Equal(tag, "top") || Equal(tag, "include") || Equal(tag, "import") || Equal(tag, "namespace") || Equal(tag, "extern"))
+      profile = 0;
+  }
+
   /*
      symtab = Getattr(n,"symtab");
      if (symtab) {
      symtab = Swig_symbol_setscope(symtab);
      }
    */
+  if (profile)
+    Swig_profile_decl_begin(n);
   ret = Dispatcher::emit_one(n);
+  if (profile)
+    Swig_profile_decl_end(n);
   /*
      if (symtab) {
      Swig_symbol_setscope(symtab);
@@ -609,7 +628,7 @@ int Language::constantDirective(Node *n) {
       /*      Printf(stdout,"'%s' = '%s'\n", name, value); */
     }
     Setattr(n, "value", value);
-    this->constantWrapper(n);
+    PROFILE_HANDLER(constantWrapper, n);
     Swig_restore(n);
     return SWIG_OK;
   }
@@ -689,7 +708,7 @@ int Language::moduleDirective(Node *n) {
 
 int Language::nativeDirective(Node *n) {
   if (!ImportMode) {
-    return nativeWrapper(n);
+    return PROFILE_HANDLER(nativeWrapper, n);
   } else {
     return SWIG_NOWRAP;
   }
@@ -1007,7 +1026,7 @@ int Language::cDeclaration(Node *n) {
     DohIncref(type);
     Setattr(n, "type", ty);
 
-    functionHandler(n);
+    PROFILE_HANDLER(functionHandler, n);
 
     Setattr(n, "type", type);
     Delete(ty);
@@ -1042,7 +1061,7 @@ int Language::cDeclaration(Node *n) {
     }
     DohIncref(type);
     Setattr(n, "type", ty);
-    variableHandler(n);
+    PROFILE_HANDLER(variableHandler, n);
     Setattr(n, "type", type);
     Setattr(n, "decl", declaration);
     Delete(ty);
@@ -1071,14 +1090,14 @@ int Language::functionHandler(Node *n) {
     }
   }
   if (!CurrentClass) {
-    globalfunctionHandler(n);
+    PROFILE_HANDLER(globalfunctionHandler, n);
   } else {
     if (isstatic) {
-      staticmemberfunctionHandler(n);
+      PROFILE_HANDLER(staticmemberfunctionHandler, n);
     } else if (isfriend) {
       int oldInClass = InClass;
       InClass = 0;
-      globalfunctionHandler(n);
+      PROFILE_HANDLER(globalfunctionHandler, n);
       InClass = oldInClass;
     } else {
       // This is a member function, set a flag so the documentation type is correct
@@ -1101,10 +1120,10 @@ int Language::functionHandler(Node *n) {
 	}
       }
 
-      memberfunctionHandler(n);
+      PROFILE_HANDLER(memberfunctionHandler, n);
 
       if (explicit_n) {
-	memberfunctionHandler(explicit_n);
+	PROFILE_HANDLER(memberfunctionHandler, explicit_n);
 	Delattr(explicit_n, "explicitcall");
 	Delete(explicit_n);
       }
@@ -1151,7 +1170,7 @@ int Language::globalfunctionHandler(Node *n) {
   Setattr(n, "wrap:action", cres);
   Delete(cres);
   Delete(call);
-  functionWrapper(n);
+  PROFILE_HANDLER(functionWrapper, n);
 
   Swig_restore(n);
   return SWIG_OK;
@@ -1178,7 +1197,7 @@ int Language::callbackfunctionHandler(Node *n) {
 
   Node *ns = symbolLookup(cbname);
   if (!ns)
-    constantWrapper(n);
+    PROFILE_HANDLER(constantWrapper, n);
 
   Delete(cbty);
 
@@ -1229,7 +1248,7 @@ int Language::memberfunctionHandler(Node *n) {
     Setfile(cbn, Getfile(n));
     Setline(cbn, Getline(n));
 
-    memberconstantHandler(cbn);
+    PROFILE_HANDLER(memberconstantHandler, cbn);
     Setattr(n, "feature:callback:name", Swig_name_member(NSpace, ClassPrefix, cbname));
 
     Delete(cb);
@@ -1276,7 +1295,7 @@ int Language::memberfunctionHandler(Node *n) {
   Setattr(n, "doc:low:name", fname);
   Setattr(n, "doc:high:name", symname);
 
-  functionWrapper(n);
+  PROFILE_HANDLER(functionWrapper, n);
 
   Delete(director_type);
   Delete(fname);
@@ -1346,7 +1365,7 @@ int Language::staticmemberfunctionHandler(Node *n) {
   }
   Delattr(n, "storage");
 
-  globalfunctionHandler(n);
+  PROFILE_HANDLER(globalfunctionHandler, n);
 
   Delete(cname);
   Delete(mrename);
@@ -1379,7 +1398,7 @@ int Language::variableHandler(Node *n) {
   }
 
   if (!CurrentClass) {
-    globalvariableHandler(n);
+    PROFILE_HANDLER(globalvariableHandler, n);
   } else {
     Swig_save("variableHandler", n, "feature:immutable", NIL);
     if (SmartPointer) {
@@ -1389,9 +1408,9 @@ int Language::variableHandler(Node *n) {
       }
     }
     if (Swig_storage_isstatic(n) && !(SmartPointer && Getattr(n, "allocate:smartpointeraccess"))) {
-      staticmembervariableHandler(n);
+      PROFILE_HANDLER(staticmembervariableHandler, n);
     } else {
-      membervariableHandler(n);
+      PROFILE_HANDLER(membervariableHandler, n);
     }
     Swig_restore(n);
   }
@@ -1403,7 +1422,7 @@ int Language::variableHandler(Node *n) {
  * ---------------------------------------------------------------------- */
 
 int Language::globalvariableHandler(Node *n) {
-  variableWrapper(n);
+  PROFILE_HANDLER(variableWrapper, n);
   return SWIG_OK;
 }
 
@@ -1494,7 +1513,7 @@ int Language::membervariableHandler(Node *n) {
       }
       if (make_set_wrapper) {
 	Setattr(n, "sym:name", mrename_set);
-	functionWrapper(n);
+	PROFILE_HANDLER(functionWrapper, n);
       } else {
 	SetFlag(n, "feature:immutable");
       }
@@ -1519,7 +1538,7 @@ int Language::membervariableHandler(Node *n) {
       Swig_MembergetToFunction(n, ClassType, flags);
       Setattr(n, "sym:name", mrename_get);
       Setattr(n, "memberget", "1");
-      functionWrapper(n);
+      PROFILE_HANDLER(functionWrapper, n);
       Delattr(n, "memberget");
     }
     Delete(mrename_get);
@@ -1590,7 +1609,7 @@ int Language::staticmembervariableHandler(Node *n) {
     Setattr(n, "name", cname);
 
     /* Wrap as an ordinary global variable */
-    variableWrapper(n);
+    PROFILE_HANDLER(variableWrapper, n);
 
     Delete(mrename);
     Delete(cname);
@@ -1638,7 +1657,7 @@ int Language::staticmembervariableHandler(Node *n) {
     Delete(t1);
     Delete(t2);
     SetFlag(n, "wrappedasconstant");
-    memberconstantHandler(n);
+    PROFILE_HANDLER(memberconstantHandler, n);
     Delete(cname);
   }
 
@@ -1717,9 +1736,9 @@ int Language::enumvalueDeclaration(Node *n) {
 
   if (!CurrentClass || !cparse_cplusplus) {
     Setattr(n, "name", tmpValue);	/* for wrapping of enums in a namespace when emit_action is used */
-    constantWrapper(n);
+    PROFILE_HANDLER(constantWrapper, n);
   } else {
-    memberconstantHandler(n);
+    PROFILE_HANDLER(memberconstantHandler, n);
   }
 
   Delete(tmpValue);
@@ -1734,7 +1753,7 @@ int Language::enumvalueDeclaration(Node *n) {
 int Language::enumforwardDeclaration(Node *n) {
   (void) n;
   if (GetFlag(n, "enumMissing"))
-    enumDeclaration(n); // Generate an empty enum in target language
+    PROFILE_HANDLER(enumDeclaration, n); // Generate an empty enum in target language
   return SWIG_OK;
 }
 
@@ -1770,7 +1789,7 @@ int Language::memberconstantHandler(Node *n) {
     new_name = NewStringf("%s::%s", isNonVirtualProtectedAccess(n) ? DirectorClassName : ClassName, name);
   Setattr(n, "name", new_name);
 
-  constantWrapper(n);
+  PROFILE_HANDLER(constantWrapper, n);
   Delete(mrename);
   Delete(new_name);
   Swig_restore(n);
@@ -2025,7 +2044,7 @@ int Language::classDirectorDisown(Node *n) {
   Delete(type);
   Delete(p);
 
-  functionWrapper(disown);
+  PROFILE_HANDLER(functionWrapper, disown);
   Delete(disown);
   return SWIG_OK;
 }
@@ -2513,12 +2532,12 @@ int Language::classDeclaration(Node *n) {
 
     if (dir) {
       DirectorClassName = directorClassName(n);
-      classDirector(n);
+      PROFILE_HANDLER(classDirector, n);
     }
     /* check for abstract after resolving directors */
 
     Abstract = abstractClassTest(n);
-    classHandler(n);
+    PROFILE_HANDLER(classHandler, n);
   } else {
     Abstract = abstractClassTest(n);
     Language::classHandler(n);
@@ -2701,7 +2720,7 @@ int Language::constructorDeclaration(Node *n) {
       /* If the symbol is overloaded.  We check to see if it is a copy constructor.  If so, 
          we invoke copyconstructorHandler() as a special case. */
       if (Getattr(n, "copy_constructor") && (!Getattr(CurrentClass, "has_copy_constructor"))) {
-	copyconstructorHandler(n);
+	PROFILE_HANDLER(copyconstructorHandler, n);
 	Setattr(CurrentClass, "has_copy_constructor", "1");
       } else {
 	if (Getattr(over, "copy_constructor"))
@@ -2712,7 +2731,7 @@ int Language::constructorDeclaration(Node *n) {
 	  Swig_warning(WARN_LANG_OVERLOAD_CONSTRUCT, Getfile(over), Getline(over),
 		       "Previous declaration is %s\n", Swig_name_decl(over));
 	} else {
-	  constructorHandler(n);
+	  PROFILE_HANDLER(constructorHandler, n);
 	}
       }
     } else {
@@ -2749,7 +2768,7 @@ int Language::constructorDeclaration(Node *n) {
 	  return SWIG_NOWRAP;
 	}
       }
-      constructorHandler(n);
+      PROFILE_HANDLER(constructorHandler, n);
     }
   }
   Setattr(CurrentClass, "has_constructor", "1");
@@ -2812,7 +2831,7 @@ int Language::constructorHandler(Node *n) {
   int flags = Getattr(n, "template") ? extendmember : Extend;
   Swig_ConstructorToFunction(n, NSpace, ClassType, none_comparison, director_ctor, CPlusPlus, flags, DirectorClassName);
   Setattr(n, "sym:name", mrename);
-  functionWrapper(n);
+  PROFILE_HANDLER(functionWrapper, n);
   Delete(mrename);
   Swig_restore(n);
   if (abstracts)
@@ -2834,7 +2853,7 @@ int Language::copyconstructorHandler(Node *n) {
 						 abstracts);
   Swig_ConstructorToFunction(n, NSpace, ClassType, none_comparison, director_ctor, CPlusPlus, Getattr(n, "template") ? 0 : Extend, DirectorClassName);
   Setattr(n, "sym:name", mrename);
-  functionWrapper(n);
+  PROFILE_HANDLER(functionWrapper, n);
   Delete(mrename);
   Swig_restore(n);
   if (abstracts)
@@ -2903,7 +2922,7 @@ int Language::destructorDeclaration(Node *n) {
       return SWIG_NOWRAP;
     }
   }
-  destructorHandler(n);
+  PROFILE_HANDLER(destructorHandler, n);
 
   Setattr(CurrentClass, "has_destructor", "1");
   Swig_restore(n);
@@ -2928,7 +2947,7 @@ int Language::destructorHandler(Node *n) {
 
   Swig_DestructorToFunction(n, NSpace, ClassType, CPlusPlus, Extend);
   Setattr(n, "sym:name", mrename);
-  functionWrapper(n);
+  PROFILE_HANDLER(functionWrapper, n);
   Delete(mrename);
   Swig_restore(n);
   return SWIG_OK;
@@ -3058,7 +3077,7 @@ int Language::variableWrapper(Node *n) {
     }
     if (make_set_wrapper) {
       Setattr(n, "varset", "1");
-      functionWrapper(n);
+      PROFILE_HANDLER(functionWrapper, n);
     } else {
       SetFlag(n, "feature:immutable");
     }
@@ -3081,7 +3100,7 @@ int Language::variableWrapper(Node *n) {
   Setattr(n, "sym:name", gname);
   Delete(gname);
   Setattr(n, "varget", "1");
-  functionWrapper(n);
+  PROFILE_HANDLER(functionWrapper, n);
   Delattr(n, "varget");
   Swig_restore(n);
   Delete(newsymname);
@@ -25,6 +25,11 @@
 #include <ctype.h>
 #include <errno.h>
 #include <limits.h>		// for INT_MAX
+#if defined(HAVE_FORK)
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 // Global variables
 
@@ -81,6 +86,8 @@ static const char *usage1 = (const char *) "\
      -debug-typemap  - Display typemap debugging information\n\
      -debug-tmsearch - Display typemap search debugging information\n\
      -debug-tmused   - Display typemaps used debugging information\n\
+     -debug-tmcache  - Display typemap search cache statistics\n\
+     -debug-tdcache  - Display typedef resolution cache statistics\n\
      -directors      - Turn on director mode for all the classes, mainly for testing\n\
      -dirprot        - Turn on wrapping of protected members for director classes (default)\n\
      -D<symbol>      - Define a symbol <symbol> (for conditional compilation)\n\
@@ -95,6 +102,7 @@ static const char *usage2 = (const char *) "\
                        features, eg -features directors,autodoc=1\n\
                        If no explicit value is given to the feature, a default of 1 is used\n\
      -fastdispatch   - Enable fast dispatch mode to produce faster overload dispatcher code\n\
+     -fastexit       - Exit without freeing the parse tree, leaving it to the operating system\n\
      -Fmicrosoft     - Display error/warning messages in Microsoft format\n\
      -Fstandard      - Display error/warning messages in commonly used format\n\
      -fvirtual       - Compile in virtual elimination mode\n\
@@ -103,6 +111,7 @@ static const char *usage2 = (const char *) "\
      -I<dir>         - Look for SWIG files in directory <dir>\n\
      -ignoremissing  - Ignore missing include files\n\
      -importall      - Follow all #include statements as imports\n\
+     -importcache <dir>- Cache preprocessed %import files in directory <dir>\n\
      -includeall     - Follow all #include statements\n\
      -l<ifile>       - Include SWIG library file <ifile>\n\
 ";
@@ -138,8 +147,12 @@ static const char *usage4 = (const char *) "\
      -outcurrentdir  - Set default output dir to current dir instead of input file's path\n\
      -outdir <dir>   - Set language specific files output directory to <dir>\n\
      -pcreversion    - Display PCRE version information\n\
+     -profile[=json] - Display the time spent in each processing phase, language handler, the typemap\n\
+                       and fragment subsystems and the most expensive declarations and files\n\
      -small          - Compile in virtual elimination and compact mode\n\
      -swiglib        - Report location of SWIG library and exit\n\
+     -targets <list> - Generate wrappers for a comma separated list of target languages in parallel,\n\
+                       eg -targets python,java\n\
      -templatereduce - Reduce all the typedefs in templates\n\
      -v              - Run in verbose mode\n\
      -version        - Display SWIG version number\n\
@@ -185,6 +198,8 @@ static int no_cpp = 0;
 static String *outfile_name = 0;
 static String *outfile_name_h = 0;
 static int tm_debug = 0;
+static int tmcache_debug = 0;
+static int tdcache_debug = 0;
 static int dump_symtabs = 0;
 static int dump_symbols = 0;
 static int dump_csymbols = 0;
@@ -201,6 +216,8 @@ static int depend = 0;
 static int depend_only = 0;
 static int depend_phony = 0;
 static int memory_debug = 0;
+static int fast_exit = 0;
+static const char *target_name = 0;	// Target language name, the subdirectory for its output files when using -targets
 static int allkw = 0;
 static DOH *cpps = 0;
 static String *dependencies_file = 0;
@@ -297,6 +314,38 @@ static unsigned int decode_numbers_list(String *numlist) {
   return decoded_number;
 }
 
+/* -----------------------------------------------------------------------------
+ * target_subdirectory()
+ * target_path()
+ *
+ * When generating for multiple target languages (-targets), the output files of
+ * each target language are put in a subdirectory named after the language of the
+ * directory they would otherwise be in, so that they are kept separate.
+ * target_subdirectory() creates the subdirectory of dir, which is empty or ends
+ * with a file delimiter, if necessary and target_path() returns the path for an
+ * output file.
+ * ----------------------------------------------------------------------------- */
+
+static void target_subdirectory(String *dir) {
+  String *subdirectory = NewString(target_name);
+  String *error = Swig_new_subdirectory(dir, subdirectory);
+  if (error) {
+    Printf(stderr, "%s\n", error);
+    SWIG_exit(EXIT_FAILURE);
+  }
+  Delete(subdirectory);
+}
+
+static String *target_path(const String *path) {
+  String *dir = Swig_file_dirname(path);
+  String *filename = Swig_file_filename(path);
+  target_subdirectory(dir);
+  String *result = NewStringf("%s%s%s%s", dir, target_name, SWIG_FILE_DELIMITER, filename);
+  Delete(filename);
+  Delete(dir);
+  return result;
+}
+
 /* -----------------------------------------------------------------------------
  * Sets the output directory for language specific (proxy) files from the
  * C wrapper file if not set and corrects the directory name and adds a trailing
@@ -306,7 +355,8 @@ static unsigned int decode_numbers_list(String *numlist) {
 static void configure_outdir(const String *c_wrapper_outfile) {
 
   // Use the C wrapper file's directory if the output directory has not been set by user
-  if (!outdir || Len(outdir) == 0)
+  int user_outdir = outdir && Len(outdir) > 0;
+  if (!user_outdir)
     outdir = Swig_file_dirname(c_wrapper_outfile);
 
   Swig_filename_correct(outdir);
@@ -317,6 +367,12 @@ static void configure_outdir(const String *c_wrapper_outfile) {
     if (strcmp(outd + strlen(outd) - strlen(SWIG_FILE_DELIMITER), SWIG_FILE_DELIMITER) != 0)
       Printv(outdir, SWIG_FILE_DELIMITER, NIL);
   }
+
+  // Use a target language subdirectory when using -targets, the C wrapper file is already in one
+  if (user_outdir && target_name) {
+    target_subdirectory(outdir);
+    Printv(outdir, target_name, SWIG_FILE_DELIMITER, NIL);
+  }
 }
 
 /* This function sets the name of the configuration file */
@@ -509,6 +565,9 @@ static void getoptions(int argc, char *argv[]) {
       } else if (strcmp(argv[i], "-fastdispatch") == 0) {
 	Wrapper_fast_dispatch_mode_set(1);
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-fastexit") == 0) {
+	fast_exit = 1;
+	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-nofastdispatch") == 0) {
 	Wrapper_fast_dispatch_mode_set(0);
 	Swig_mark_arg(i);
@@ -531,6 +590,12 @@ static void getoptions(int argc, char *argv[]) {
 	Delete(version);
 	Swig_mark_arg(i);
 	SWIG_exit(EXIT_SUCCESS);
+      } else if (strcmp(argv[i], "-profile") == 0) {
+	Swig_profile_enable(0);
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-profile=json") == 0) {
+	Swig_profile_enable(1);
+	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-small") == 0) {
 	Wrapper_compact_print_mode_set(1);
 	Wrapper_virtual_elimination_mode_set(1);
@@ -680,6 +745,15 @@ static void getoptions(int argc, char *argv[]) {
       } else if (strcmp(argv[i], "-importall") == 0) {
 	Preprocessor_import_all(1);
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-importcache") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  Preprocessor_import_cache(argv[i + 1]);
+	  Swig_mark_arg(i + 1);
+	  i++;
+	} else {
+	  Swig_arg_error();
+	}
       } else if (strcmp(argv[i], "-ignoremissing") == 0) {
 	Preprocessor_ignore_missing(1);
 	Swig_mark_arg(i);
@@ -707,6 +781,12 @@ static void getoptions(int argc, char *argv[]) {
       } else if (strcmp(argv[i], "-debug-tmused") == 0) {
 	Swig_typemap_used_debug_set();
 	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-tmcache") == 0) {
+	tmcache_debug = 1;
+	Swig_mark_arg(i);
+      } else if (strcmp(argv[i], "-debug-tdcache") == 0) {
+	tdcache_debug = 1;
+	Swig_mark_arg(i);
       } else if (strcmp(argv[i], "-module") == 0) {
 	Swig_mark_arg(i);
 	if (argv[i + 1]) {
@@ -1096,7 +1176,9 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
 	  Printf(fs, "\n%%include \"%s\"\n", Swig_filename_escape(Getitem(libfiles, i)));
 	}
 	Seek(fs, 0, SEEK_SET);
+	Swig_profile_begin("phase:preprocess");
 	cpps = Preprocessor_parse(fs);
+	Swig_profile_end("phase:preprocess");
 	Delete(fs);
       } else {
 	cpps = Swig_read_file(df);
@@ -1116,6 +1198,11 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
 
 	  String *inputfile_filename = outcurrentdir ? Swig_file_filename(input_file): Copy(input_file);
 	  String *basename = Swig_file_basename(inputfile_filename);
+	  if (target_name) {
+	    String *target_basename = target_path(basename);
+	    Delete(basename);
+	    basename = target_basename;
+	  }
 	  if (!outfile_name) {
 	    if (CPlusPlus || lang->cplus_runtime_mode()) {
 	      outfile = NewStringf("%s_wrap.%s", basename, cpp_extension);
@@ -1123,7 +1210,7 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
 	      outfile = NewStringf("%s_wrap.c", basename);
 	    }
 	  } else {
-	    outfile = NewString(outfile_name);
+	    outfile = target_name ? target_path(outfile_name) : NewString(outfile_name);
 	  }
 	  if (dependencies_file && Len(dependencies_file) != 0) {
 	    f_dependencies_file = NewFile(dependencies_file, "w", SWIG_output_files());
@@ -1172,6 +1259,7 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
 	    SWIG_exit(EXIT_SUCCESS);
 	  Delete(inputfile_filename);
 	  Delete(basename);
+	  Delete(outfile);
 	  Delete(phony_targets);
 	} else {
 	  Printf(stderr, "Cannot generate dependencies with -nopreprocess\n");
@@ -1191,7 +1279,9 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
       fflush(stdout);
     }
 
+    Swig_profile_begin("phase:parse");
     Node *top = Swig_cparse(cpps);
+    Swig_profile_end("phase:parse");
 
     if (dump_top & STAGE1) {
       Printf(stdout, "debug-top stage 1\n");
@@ -1211,7 +1301,9 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
     if (Verbose) {
       Printf(stdout, "Processing types...\n");
     }
+    Swig_profile_begin("phase:typepass");
     Swig_process_types(top);
+    Swig_profile_end("phase:typepass");
 
     if (dump_top & STAGE2) {
       Printf(stdout, "debug-top stage 2\n");
@@ -1225,12 +1317,16 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
     if (Verbose) {
       Printf(stdout, "C++ analysis...\n");
     }
+    Swig_profile_begin("phase:allocate");
     Swig_default_allocators(top);
+    Swig_profile_end("phase:allocate");
 
     if (CPlusPlus) {
       if (Verbose)
 	Printf(stdout, "Processing nested classes...\n");
+      Swig_profile_begin("phase:nested");
       Swig_nested_process_classes(top);
+      Swig_profile_end("phase:nested");
     }
 
     if (dump_top & STAGE3) {
@@ -1308,6 +1404,14 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
 	} else {
 	  Setattr(top, "outfile_h", outfile_name_h);
 	}
+	if (target_name) {
+	  String *target_outfile = target_path(Getattr(top, "outfile"));
+	  String *target_outfile_h = target_path(Getattr(top, "outfile_h"));
+	  Setattr(top, "outfile", target_outfile);
+	  Setattr(top, "outfile_h", target_outfile_h);
+	  Delete(target_outfile_h);
+	  Delete(target_outfile);
+	}
 	configure_outdir(Getattr(top, "outfile"));
 	if (Swig_contract_mode_get()) {
 	  Swig_contracts(top);
@@ -1323,7 +1427,9 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
 	    tlm->help ? tlm->help : "", tlm->name);
 	}
 
+	Swig_profile_begin("phase:wrap");
 	lang->top(top);
+	Swig_profile_end("phase:wrap");
 
 	if (browse) {
 	  Swig_browser(top, 0);
@@ -1348,10 +1454,21 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
       lang = 0;
       Swig_print_xml(top, xmlout);
     }
-    Delete(top);
+    /* Tearing down a large parse tree object by object is slow and pointless
+       as the memory is given back to the operating system on exit anyway */
+    if (!fast_exit) {
+      Swig_profile_begin("phase:cleanup");
+      Delete(top);
+      Swig_profile_end("phase:cleanup");
+    }
   }
   if (tm_debug)
     Swig_typemap_debug();
+  if (tmcache_debug)
+    Swig_typemap_search_cache_debug();
+  if (tdcache_debug)
+    SwigType_typedef_cache_debug();
+  Swig_profile_report(stdout);
   if (memory_debug)
     DohMemoryDebug();
 
@@ -1388,6 +1505,60 @@ int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm) {
   return 0;
 }
 
+/* -----------------------------------------------------------------------------
+ * SWIG_main_targets()
+ *
+ * Generate wrappers for multiple target languages (the -targets option).  Each
+ * target language is run by SWIG_main() in its own forked process, so they run
+ * in parallel and the output for each language is the same as for a separate
+ * SWIG run, except that it is put in a subdirectory named after the target
+ * language, see target_path().  Note that the interface is parsed separately for each
+ * target language as the preprocessor symbols and the SWIG library files used
+ * depend on the target language.
+ * ----------------------------------------------------------------------------- */
+
+int SWIG_main_targets(int argc, char *argv[], const TargetLanguageModule **tlms, int ntargets) {
+  if (ntargets == 1)
+    return SWIG_main(argc, argv, tlms[0]);
+
+#if defined(HAVE_FORK)
+  int i;
+  int result = EXIT_SUCCESS;
+  pid_t *pids = new pid_t[ntargets];
+
+  fflush(stdout);
+  fflush(stderr);
+  for (i = 0; i < ntargets; i++) {
+    pids[i] = fork();
+    if (pids[i] == 0) {
+      target_name = tlms[i]->name + 1;
+      exit(SWIG_main(argc, argv, tlms[i]));
+    } else if (pids[i] < 0) {
+      Printf(stderr, "Unable to start SWIG for target language %s: %s\n", tlms[i]->name + 1, strerror(errno));
+      result = EXIT_FAILURE;
+    }
+  }
+
+  for (i = 0; i < ntargets; i++) {
+    int status = 0;
+    if (pids[i] <= 0)
+      continue;
+    if (waitpid(pids[i], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      if (WIFSIGNALED(status))
+	Printf(stderr, "SWIG for target language %s terminated by signal %d\n", tlms[i]->name + 1, WTERMSIG(status));
+      result = EXIT_FAILURE;
+    }
+  }
+  delete [] pids;
+  return result;
+#else
+  (void)argc;
+  (void)argv;
+  Printf(stderr, "The -targets option is not supported on this platform, run SWIG separately for each target language.\n");
+  return EXIT_FAILURE;
+#endif
+}
+
 /* -----------------------------------------------------------------------------
  * SWIG_exit()
  *
@@ -56,6 +56,7 @@ static Hash *builtin_closures = 0;
 static Hash *class_members = 0;
 static File *f_builtins = 0;
 static String *builtin_tp_init = 0;
+static String *builtin_tp_vectorcall = 0;
 static String *builtin_methods = 0;
 static String *builtin_default_unref = 0;
 static String *builtin_closures_code = 0;
@@ -86,6 +87,7 @@ static int dirvtable = 0;
 static int doxygen = 0;
 static int fastunpack = 1;
 static int fastproxy = 0;
+static int fastcall = 0;
 static int olddefs = 0;
 static int castmode = 0;
 static int extranative = 0;
@@ -111,9 +113,10 @@ Python Options (available with -python)\n\
      -castmode       - Enable the casting mode, which allows implicit cast between types in Python\n\
      -debug-doxygen-parser     - Display doxygen parser module debugging information\n\
      -debug-doxygen-translator - Display doxygen translator module debugging information\n\
-     -dirvtable      - Generate a pseudo virtual table for directors for faster dispatch\n\
+     -dirvtable      - Cache the Python methods called by directors for faster dispatch\n\
      -doxygen        - Convert C++ doxygen comments to pydoc comments in proxy classes\n\
      -extranative    - Return extra native wrappers for C++ std containers wherever possible\n\
+     -fastcall       - Call functions taking several arguments with a vector of arguments (METH_FASTCALL)\n\
      -fastproxy      - Use fast proxy mechanism for member methods\n\
      -globals <name> - Set <name> used to access C global variable (default: 'cvar')\n\
      -interface <mod>- Set low-level C/C++ module name to <mod> (default: module name prefixed by '_')\n\
@@ -362,6 +365,9 @@ public:
 	} else if (strcmp(argv[i], "-fastproxy") == 0) {
 	  fastproxy = 1;
 	  Swig_mark_arg(i);
+	} else if (strcmp(argv[i], "-fastcall") == 0) {
+	  fastcall = 1;
+	  Swig_mark_arg(i);
 	} else if (strcmp(argv[i], "-olddefs") == 0) {
 	  olddefs = 1;
 	  Swig_mark_arg(i);
@@ -2397,7 +2403,10 @@ public:
 
   void add_method(String *name, String *function, int kw, Node *n = 0, int funpack = 0, int num_required = -1, int num_arguments = -1) {
     String * meth_str = NewString("");
-    if (!kw) {
+    if (n && GetFlag(n, "python:fastcall")) {
+      // Cast via void(*)(void) as the function does not have the PyCFunction signature
+      Printf(meth_str, "\t { \"%s\", (PyCFunction)(void(*)(void))%s, %s, ", name, function, kw ? "SWIGPY_METH_FASTCALL|METH_KEYWORDS" : "SWIGPY_METH_FASTCALL");
+    } else if (!kw) {
       if (funpack) {
 	if (num_required == 0 && num_arguments == 0) {
 	  Printf(meth_str, "\t { \"%s\", %s, METH_NOARGS, ", name, function);
@@ -2673,6 +2682,9 @@ public:
 	return SWIG_ERROR;
     }
 
+    /* The getter and setter of a variable are wrapped from the same node */
+    Delattr(n, "python:fastcall");
+
     f = NewWrapper();
     self_parse = NewString("");
     parse_args = NewString("");
@@ -2878,6 +2890,20 @@ public:
 
     if (builtin && !funpack && in_class && tuple_arguments == 0) {
       Printf(parse_args, "    if (args && PyTuple_Check(args) && PyTuple_GET_SIZE(args) > 0) SWIG_exception_fail(SWIG_TypeError, \"%s takes no arguments\");\n", iname);
+    } else if (allow_kwargs && !use_parse && fastcall && !Getattr(n, "feature:python:slot") && !emit_isvarargs(l)) {
+      /* Keyword arguments unpacked from a vector of arguments, the names of the arguments are interned once */
+      Clear(f->def);
+      Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", SWIGPY_FASTCALL_KEYWORDS_PARMS) {", NIL);
+      Clear(parse_args);
+      sprintf(source, "PyObject *swig_obj[%d]", tuple_arguments);
+      Wrapper_add_localv(f, "swig_obj", source, NIL);
+      sprintf(source, "static PyObject *swig_kwinterned[%d] = {0}", tuple_arguments);
+      Wrapper_add_localv(f, "swig_kwinterned", source, NIL);
+      Printf(parse_args, "if (!SWIG_Python_UnpackKeywordArgs(\"%s\", %d, %d, kwnames, swig_kwinterned, swig_obj)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments);
+      for (i = 0; i < tuple_arguments; i++)
+	Printf(parse_args, "obj%d = swig_obj[%d];\n", (add_self ? i + 1 : i) + (builtin_ctor ? 1 : 0), i);
+      SetFlag(n, "python:fastcall");
+      funpack = 0;
     } else if (use_parse || allow_kwargs) {
       Printf(parse_args, ":%s\"", iname);
       Printv(parse_args, arglist, ")) SWIG_fail;\n", NIL);
@@ -2895,13 +2921,20 @@ public:
 	  Printf(parse_args, "if ((nobjs < %d) || (nobjs > %d)) SWIG_fail;\n", num_required, num_arguments);
 	} else {
 	  int is_tp_call = Equal(Getattr(n, "feature:python:slot"), "tp_call");
-	  Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", PyObject *args", builtin_kwargs, ") {", NIL);
 	  if (onearg && !builtin_ctor && !is_tp_call) {
+	    Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", PyObject *args", builtin_kwargs, ") {", NIL);
 	    Printf(parse_args, "if (!args) SWIG_fail;\n");
 	    Append(parse_args, "swig_obj[0] = args;\n");
+	  } else if ((!noargs || builtin_ctor) && fastcall && !Getattr(n, "feature:python:slot")) {
+	    /* Constructors are called by the closures for tp_init and tp_vectorcall, which also pass the keyword arguments */
+	    Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, builtin_ctor ? ", SWIGPY_FASTCALL_KEYWORDS_PARMS) {" : ", SWIGPY_FASTCALL_PARMS) {", NIL);
+	    Printf(parse_args, "if (!SWIG_Python_UnpackArgs(\"%s\", %d, %d, %s)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments, noargs ? "0" : "swig_obj");
+	    SetFlag(n, "python:fastcall");
 	  } else if (!noargs) {
+	    Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", PyObject *args", builtin_kwargs, ") {", NIL);
 	    Printf(parse_args, "if (!SWIG_Python_UnpackTuple(args, \"%s\", %d, %d, swig_obj)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments);
 	  } else if (noargs) {
+	    Printv(f->def, linkage, wrap_return, wname, "(PyObject *", self_param, ", PyObject *args", builtin_kwargs, ") {", NIL);
 	    Printf(parse_args, "if (!SWIG_Python_UnpackTuple(args, \"%s\", %d, %d, 0)) SWIG_fail;\n", iname, num_fixed_arguments, tuple_arguments);
 	  }
 	}
@@ -3237,8 +3270,16 @@ public:
     if (builtin_ctor) {
       if ((director_method || !is_private(n)) && !Getattr(class_members, iname)) {
 	Setattr(class_members, iname, n);
-	if (!builtin_tp_init)
+	if (!builtin_tp_init) {
 	  builtin_tp_init = Swig_name_wrapper(iname);
+	  if (GetFlag(n, "python:fastcall")) {
+	    /* The constructor takes a vector of arguments, so the slots call it through closures */
+	    Printf(builtin_closures_code, "SWIGPY_INITPROC_CLOSURE(%s) /* defines %s_initproc_closure */\n\n", builtin_tp_init, builtin_tp_init);
+	    Printf(builtin_closures_code, "SWIGPY_VECTORCALLFUNC_CLOSURE(%s) /* defines %s_vectorcallfunc_closure */\n\n", builtin_tp_init, builtin_tp_init);
+	    builtin_tp_vectorcall = NewStringf("%s_vectorcallfunc_closure", builtin_tp_init);
+	    Append(builtin_tp_init, "_initproc_closure");
+	  }
+	}
       }
     }
 
@@ -3780,23 +3821,21 @@ public:
       Printf(f_directors_h, "\n");
       Printf(f_directors_h, "#if defined(SWIG_PYTHON_DIRECTOR_VTABLE)\n");
       Printf(f_directors_h, "/* VTable implementation */\n");
-      Printf(f_directors_h, "    PyObject *swig_get_method(size_t method_index, const char *method_name) const {\n");
-      Printf(f_directors_h, "      PyObject *method = vtable[method_index];\n");
-      Printf(f_directors_h, "      if (!method) {\n");
-      Printf(f_directors_h, "        swig::SwigVar_PyObject name = SWIG_Python_str_FromChar(method_name);\n");
-      Printf(f_directors_h, "        method = PyObject_GetAttr(swig_get_self(), name);\n");
-      Printf(f_directors_h, "        if (!method) {\n");
-      Printf(f_directors_h, "          std::string msg = \"Method in class %s doesn't exist, undefined \";\n", classname);
-      Printf(f_directors_h, "          msg += method_name;\n");
-      Printf(f_directors_h, "          Swig::DirectorMethodException::raise(msg.c_str());\n");
-      Printf(f_directors_h, "        }\n");
-      Printf(f_directors_h, "        vtable[method_index] = method;\n");
-      Printf(f_directors_h, "      }\n");
-      Printf(f_directors_h, "      return method;\n");
-      Printf(f_directors_h, "    }\n");
-      Printf(f_directors_h, "private:\n");
-      Printf(f_directors_h, "    mutable swig::SwigVar_PyObject vtable[%d];\n", director_method_index);
+      Printf(f_directors_h, "    PyObject *swig_get_method(size_t method_index, const char *method_name, bool pure_virtual, PyObject **method_self) const;\n");
       Printf(f_directors_h, "#endif\n\n");
+
+      /* The methods are cached for each Python class, see Swig::DirectorMethodCache */
+      SwigType *ct = Copy(Getattr(n, "name"));
+      SwigType_add_pointer(ct);
+      String *mangle = SwigType_manglestr(ct);
+      Printf(f_directors, "#if defined(SWIG_PYTHON_DIRECTOR_VTABLE)\n");
+      Printf(f_directors, "PyObject *SwigDirector_%s::swig_get_method(size_t method_index, const char *method_name, bool pure_virtual, PyObject **method_self) const {\n", classname);
+      Printf(f_directors, "  static Swig::DirectorMethodCache cache(%d);\n", director_method_index);
+      Printf(f_directors, "  return cache.method(swig_get_self(), SWIGTYPE%s, method_index, method_name, pure_virtual, \"%s\", method_self);\n", mangle, classname);
+      Printf(f_directors, "}\n");
+      Printf(f_directors, "#endif\n\n");
+      Delete(mangle);
+      Delete(ct);
     }
 
     Printf(f_directors_h, "};\n\n");
@@ -3908,6 +3947,13 @@ public:
     // So this is done in the initialization function instead, see https://docs.python.org/2/extending/newtypes.html
     Printf(f_init, "  builtin_pytype->tp_new = %s;\n", getSlot(n, "feature:python:tp_new", tp_new));
 
+    // The type is called through tp_vectorcall, which uses tp_new without the arguments of the call
+    if (builtin_tp_vectorcall && !Getattr(n, "feature:python:tp_new") && !Getattr(n, "feature:python:tp_init")) {
+      Printv(f_init, "#ifdef SWIGPY_TP_VECTORCALL\n", NIL);
+      Printf(f_init, "  builtin_pytype->tp_vectorcall = %s;\n", builtin_tp_vectorcall);
+      Printv(f_init, "#endif\n", NIL);
+    }
+
     Printv(f_init, "  builtin_base_count = 0;\n", NIL);
     List *baselist = Getattr(n, "bases");
     if (baselist) {
@@ -4515,6 +4561,10 @@ public:
 	Delete(builtin_tp_init);
 	builtin_tp_init = 0;
       }
+      if (builtin_tp_vectorcall) {
+	Delete(builtin_tp_vectorcall);
+	builtin_tp_vectorcall = 0;
+      }
 
       if (!builtin) {
 	/* Now emit methods */
@@ -4571,7 +4621,7 @@ public:
     int oldshadow;
 
     if (builtin)
-      Swig_save("builtin_memberfunc", n, "python:argcount", NIL);
+      Swig_save("builtin_memberfunc", n, "python:argcount", "python:fastcall", NIL);
 
     /* Create the default member function */
     oldshadow = shadow;		/* Disable shadowing when wrapping member functions */
@@ -4589,7 +4639,10 @@ public:
 	Setattr(class_members, symname, n);
 	int argcount = Getattr(n, "python:argcount") ? atoi(Char(Getattr(n, "python:argcount"))) : 2;
 	String *ds = have_docstring(n) ? cdocstring(n, AUTODOC_METHOD) : NewString("");
-	if (check_kwargs(n)) {
+	if (GetFlag(n, "python:fastcall")) {
+	  Printf(builtin_methods, "  { \"%s\", (PyCFunction)(void(*)(void))%s, %s, \"%s\" },\n", symname, wname,
+		 check_kwargs(n) ? "SWIGPY_METH_FASTCALL|METH_KEYWORDS" : "SWIGPY_METH_FASTCALL", ds);
+	} else if (check_kwargs(n)) {
 	  // Cast via void(*)(void) to suppress GCC -Wcast-function-type
 	  // warning.  Python should always call the function correctly, but
 	  // the Python C API requires us to store it in function pointer of a
@@ -4690,7 +4743,9 @@ public:
 	int funpack = fastunpack && !Getattr(n, "sym:overloaded");
 	String *pyflags = NewString("METH_STATIC|");
 	int argcount = Getattr(n, "python:argcount") ? atoi(Char(Getattr(n, "python:argcount"))) : 2;
-	if (funpack && argcount == 0)
+	if (GetFlag(n, "python:fastcall"))
+	  Append(pyflags, check_kwargs(n) ? "SWIGPY_METH_FASTCALL|METH_KEYWORDS" : "SWIGPY_METH_FASTCALL");
+	else if (funpack && argcount == 0)
 	  Append(pyflags, "METH_NOARGS");
 	else if (funpack && argcount == 1)
 	  Append(pyflags, "METH_O");
@@ -5459,6 +5514,28 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
       Append(w->code, "{\n");
     }
 
+    Append(w->code, "if (!swig_get_self()) {\n");
+    Printf(w->code, "  Swig::DirectorException::raise(\"'self' uninitialized, maybe you forgot to call %s.__init__.\");\n", classname);
+    Append(w->code, "}\n");
+    Append(w->code, "#if defined(SWIG_PYTHON_DIRECTOR_VTABLE)\n");
+    Printf(w->code, "const size_t swig_method_index = %d;\n", director_method_index++);
+    Printf(w->code, "const char *const swig_method_name = \"%s\";\n", pyname);
+    if (!use_parse)
+      Append(w->code, "PyObject *swig_method_self = 0;\n");
+    Printf(w->code, "PyObject *swig_method = swig_get_method(swig_method_index, swig_method_name, %s, %s);\n", pure_virtual ? "true" : "false", use_parse ? "0" : "&swig_method_self");
+    if (!pure_virtual) {
+      /* Not overridden in Python, so release the GIL and call the C++ method without converting the arguments */
+      Append(w->code, "if (!swig_method) {\n");
+      if (allow_thread)
+	thread_end_block(n, w->code);
+      String *super_call = Swig_method_call(super, l);
+      Printf(w->code, "return %s;\n", super_call);
+      Delete(super_call);
+      Append(w->code, "}\n");
+    }
+    Append(w->code, "swig::SwigVar_PyObject method = swig_method;\n");
+    Append(w->code, "#endif\n");
+
     /* wrap complex arguments to PyObjects */
     Printv(w->code, wrap_args, NIL);
 
@@ -5467,24 +5544,12 @@ int PYTHON::classDirectorMethod(Node *n, Node *parent, String *super) {
       Printf(w->code, "swig_set_inner(\"%s\", true);\n", name);
     }
 
-
-    Append(w->code, "if (!swig_get_self()) {\n");
-    Printf(w->code, "  Swig::DirectorException::raise(\"'self' uninitialized, maybe you forgot to call %s.__init__.\");\n", classname);
-    Append(w->code, "}\n");
     Append(w->code, "#if defined(SWIG_PYTHON_DIRECTOR_VTABLE)\n");
-    Printf(w->code, "const size_t swig_method_index = %d;\n", director_method_index++);
-    Printf(w->code, "const char *const swig_method_name = \"%s\";\n", pyname);
-
-    Append(w->code, "PyObject *method = swig_get_method(swig_method_index, swig_method_name);\n");
-    if (Len(parse_args) > 0) {
-      if (use_parse) {
-	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallFunction(method, (char *)\"(%s)\" %s);\n", Swig_cresult_name(), parse_args, arglist);
-      } else {
-	Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallFunctionObjArgs(method %s, NULL);\n", Swig_cresult_name(), arglist);
-      }
+    if (use_parse) {
+      Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_CallFunction(method, (char *)\"(%s)\" %s);\n", Swig_cresult_name(), parse_args, arglist);
     } else {
-      Append(w->code, "swig::SwigVar_PyObject args = PyTuple_New(0);\n");
-      Printf(w->code, "swig::SwigVar_PyObject %s = PyObject_Call(method, (PyObject *) args, NULL);\n", Swig_cresult_name());
+      Printf(w->code, "PyObject *swig_method_args[] = { swig_method_self%s };\n", arglist);
+      Printf(w->code, "swig::SwigVar_PyObject %s = Swig::DirectorMethodCache::call(method, swig_method_args, %d);\n", Swig_cresult_name(), Len(parse_args));
     }
     Append(w->code, "#else\n");
     if (Len(parse_args) > 0) {
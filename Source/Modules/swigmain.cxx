@@ -216,6 +216,8 @@ static void merge_options_files(int *argc, char ***argv) {
 int main(int margc, char **margv) {
   int i;
   const TargetLanguageModule *language_module = 0;
+  const TargetLanguageModule **target_modules = 0;
+  int ntargets = 0;
 
   int argc;
   char **argv;
@@ -250,6 +252,39 @@ int main(int margc, char **margv) {
 	    Printf(stderr, "Target language option %s is no longer supported.\n", language_module->name);
 	  SWIG_exit(EXIT_FAILURE);
 	}
+      } else if (strcmp(argv[i], "-targets") == 0) {
+	Swig_mark_arg(i);
+	if (argv[i + 1]) {
+	  String *targets = NewString(argv[i + 1]);
+	  List *names = Split(targets, ',', -1);
+	  delete [] target_modules;
+	  target_modules = new const TargetLanguageModule *[Len(names)];
+	  ntargets = 0;
+	  for (int k = 0; k < Len(names); k++) {
+	    if (Len(Getitem(names, k)) == 0)
+	      continue;
+	    String *name = NewStringf("-%s", Getitem(names, k));
+	    const TargetLanguageModule *module = 0;
+	    for (int j = 0; modules[j].name; j++) {
+	      if (Strcmp(name, modules[j].name) == 0 && modules[j].status != Disabled) {
+		module = &modules[j];
+		break;
+	      }
+	    }
+	    if (!module) {
+	      Printf(stderr, "Unknown target language '%s' in -targets.\n", Getitem(names, k));
+	      SWIG_exit(EXIT_FAILURE);
+	    }
+	    target_modules[ntargets++] = module;
+	    Delete(name);
+	  }
+	  Delete(names);
+	  Delete(targets);
+	  Swig_mark_arg(i + 1);
+	  i++;
+	} else {
+	  Swig_arg_error();
+	}
       } else if ((strcmp(argv[i], "-help") == 0) || (strcmp(argv[i], "--help") == 0)) {
 	if (strcmp(argv[i], "--help") == 0)
 	  strcpy(argv[i], "-help");
@@ -270,7 +305,17 @@ int main(int margc, char **margv) {
     }
   }
 
-  int res = SWIG_main(argc, argv, language_module);
+  int res;
+  if (ntargets > 0) {
+    if (language_module) {
+      Printf(stderr, "A target language option (%s) cannot be used together with -targets.\n", language_module->name);
+      SWIG_exit(EXIT_FAILURE);
+    }
+    res = SWIG_main_targets(argc, argv, target_modules, ntargets);
+  } else {
+    res = SWIG_main(argc, argv, language_module);
+  }
+  delete [] target_modules;
 
   return res;
 }
@@ -369,6 +369,7 @@ struct TargetLanguageModule {
 };
 
 int SWIG_main(int argc, char *argv[], const TargetLanguageModule *tlm);
+int SWIG_main_targets(int argc, char *argv[], const TargetLanguageModule **tlms, int ntargets);
 void emit_parameter_variables(ParmList *l, Wrapper *f);
 void emit_return_variable(Node *n, SwigType *rt, Wrapper *f);
 void SWIG_config_file(const_String_or_char_ptr );
@@ -20,6 +20,12 @@
 #include "swig.h"
 #include "preprocessor.h"
 #include <ctype.h>
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
 
 static Hash *cpp = 0;		/* C preprocessor data */
 static int include_all = 0;	/* Follow all includes */
@@ -36,6 +42,12 @@ static int macro_level = 0;
 static int macro_start_line = 0;
 static const String * macro_start_file = 0;
 
+static String *import_cache_dir = 0;	/* Directory for the %import cache, see Preprocessor_import_cache() */
+static int import_cache_recording = 0;	/* Preprocessing an %import file to be stored in the cache */
+static int import_cache_nostore = 0;	/* The %import file being recorded cannot be cached */
+static List *import_cache_files = 0;	/* Files included while recording */
+static List *import_cache_skipped = 0;	/* Files not included again while recording */
+
 /* Test a character to see if it starts an identifier */
 #define isidentifier(c) ((isalpha(c)) || (c == '_') || (c == '$'))
 
@@ -85,6 +97,8 @@ static String *cpp_include(const_String_or_char_ptr fn, int sysfile) {
   if (s && single_include) {
     String *file = Getfile(s);
     if (Getattr(included_files, file)) {
+      if (import_cache_recording)
+	Append(import_cache_skipped, file);
       Delete(s);
       return 0;
     }
@@ -104,6 +118,8 @@ static String *cpp_include(const_String_or_char_ptr fn, int sysfile) {
     }
     lf = Copy(Swig_last_file());
     Append(dependencies, lf);
+    if (import_cache_recording)
+      Append(import_cache_files, lf);
     Delete(lf);
   }
   return s;
@@ -259,6 +275,8 @@ void Preprocessor_delete(void) {
   DelScanner(id_scan);
 
   Delete(dependencies);
+  Delete(import_cache_dir);
+  import_cache_dir = 0;
 
   Delete(Swig_add_directory(0));
 }
@@ -282,6 +300,18 @@ void Preprocessor_error_as_warning(int a) {
   error_as_warning = a;
 }
 
+/* -----------------------------------------------------------------------------
+ * Preprocessor_import_cache()
+ *
+ * Use the directory dir to cache the preprocessed output of %import files
+ * across SWIG runs.
+ * ----------------------------------------------------------------------------- */
+
+void Preprocessor_import_cache(const_String_or_char_ptr dir) {
+  Delete(import_cache_dir);
+  import_cache_dir = NewString(dir);
+}
+
 
 /* -----------------------------------------------------------------------------
  * Preprocessor_define()
@@ -1349,6 +1379,436 @@ static void pop_imported() {
   }
 }
 
+/* -----------------------------------------------------------------------------
+ * %import cache
+ *
+ * The preprocessed output of %import files can be stored in an on-disk cache
+ * directory and reused by later SWIG runs, see Preprocessor_import_cache().
+ * The cache key is a digest of the SWIG version, the file contents, the include
+ * search path, the preprocessor options and all the macros defined when the
+ * %import is processed.  A cache entry holds the preprocessed text, the macros
+ * defined and undefined by the imported file and the files it includes, with
+ * a digest of their contents to check they have not changed.  Files issuing
+ * diagnostics or using #pragma SWIG are not cached as these have side effects
+ * that are not recorded.  Only the outermost %import is cached, any nested
+ * %import files are part of its entry.
+ * ----------------------------------------------------------------------------- */
+
+#define IMPORT_CACHE_ROTL32(x, r) ((((x) << (r)) | ((x) >> (32 - (r)))) & 0xffffffff)
+#define IMPORT_CACHE_FMIX32(h) \
+  h ^= (h & 0xffffffff) >> 16; h *= 0x85ebca6b; \
+  h ^= (h & 0xffffffff) >> 13; h *= 0xc2b2ae35; \
+  h ^= (h & 0xffffffff) >> 16; h &= 0xffffffff
+
+/* 128 bit digest of len bytes of data (MurmurHash3 x86 128) as a hex string */
+static String *import_cache_digest(const char *data, int len) {
+  const unsigned char *c = (const unsigned char *) data;
+  const unsigned char *tail;
+  unsigned int h1 = 0x5e1f1c8b, h2 = 0x5e1f1c8b, h3 = 0x5e1f1c8b, h4 = 0x5e1f1c8b;
+  const unsigned int c1 = 0x239b961b, c2 = 0xab0e9789, c3 = 0x38b34ae5, c4 = 0xa1e38b93;
+  unsigned int k1, k2, k3, k4;
+  int i;
+
+#define IMPORT_CACHE_WORD(p) ((unsigned int) (p)[0] | ((unsigned int) (p)[1] << 8) | ((unsigned int) (p)[2] << 16) | ((unsigned int) (p)[3] << 24))
+  for (i = len / 16; i; --i, c += 16) {
+    k1 = IMPORT_CACHE_WORD(c);
+    k2 = IMPORT_CACHE_WORD(c + 4);
+    k3 = IMPORT_CACHE_WORD(c + 8);
+    k4 = IMPORT_CACHE_WORD(c + 12);
+
+    k1 *= c1; k1 = IMPORT_CACHE_ROTL32(k1, 15); k1 *= c2; h1 ^= k1;
+    h1 = IMPORT_CACHE_ROTL32(h1, 19); h1 += h2; h1 = h1 * 5 + 0x561ccd1b;
+    k2 *= c2; k2 = IMPORT_CACHE_ROTL32(k2, 16); k2 *= c3; h2 ^= k2;
+    h2 = IMPORT_CACHE_ROTL32(h2, 17); h2 += h3; h2 = h2 * 5 + 0x0bcaa747;
+    k3 *= c3; k3 = IMPORT_CACHE_ROTL32(k3, 17); k3 *= c4; h3 ^= k3;
+    h3 = IMPORT_CACHE_ROTL32(h3, 15); h3 += h4; h3 = h3 * 5 + 0x96cd1c35;
+    k4 *= c4; k4 = IMPORT_CACHE_ROTL32(k4, 18); k4 *= c1; h4 ^= k4;
+    h4 = IMPORT_CACHE_ROTL32(h4, 13); h4 += h1; h4 = h4 * 5 + 0x32ac3b17;
+  }
+#undef IMPORT_CACHE_WORD
+
+  tail = c;
+  k1 = k2 = k3 = k4 = 0;
+  switch (len & 15) {
+  case 15: k4 ^= (unsigned int) tail[14] << 16; /* FALLTHRU */
+  case 14: k4 ^= (unsigned int) tail[13] << 8; /* FALLTHRU */
+  case 13: k4 ^= (unsigned int) tail[12];
+    k4 *= c4; k4 = IMPORT_CACHE_ROTL32(k4, 18); k4 *= c1; h4 ^= k4;
+    /* FALLTHRU */
+  case 12: k3 ^= (unsigned int) tail[11] << 24; /* FALLTHRU */
+  case 11: k3 ^= (unsigned int) tail[10] << 16; /* FALLTHRU */
+  case 10: k3 ^= (unsigned int) tail[9] << 8; /* FALLTHRU */
+  case 9: k3 ^= (unsigned int) tail[8];
+    k3 *= c3; k3 = IMPORT_CACHE_ROTL32(k3, 17); k3 *= c4; h3 ^= k3;
+    /* FALLTHRU */
+  case 8: k2 ^= (unsigned int) tail[7] << 24; /* FALLTHRU */
+  case 7: k2 ^= (unsigned int) tail[6] << 16; /* FALLTHRU */
+  case 6: k2 ^= (unsigned int) tail[5] << 8; /* FALLTHRU */
+  case 5: k2 ^= (unsigned int) tail[4];
+    k2 *= c2; k2 = IMPORT_CACHE_ROTL32(k2, 16); k2 *= c3; h2 ^= k2;
+    /* FALLTHRU */
+  case 4: k1 ^= (unsigned int) tail[3] << 24; /* FALLTHRU */
+  case 3: k1 ^= (unsigned int) tail[2] << 16; /* FALLTHRU */
+  case 2: k1 ^= (unsigned int) tail[1] << 8; /* FALLTHRU */
+  case 1: k1 ^= (unsigned int) tail[0];
+    k1 *= c1; k1 = IMPORT_CACHE_ROTL32(k1, 15); k1 *= c2; h1 ^= k1;
+  }
+
+  h1 ^= (unsigned int) len; h2 ^= (unsigned int) len; h3 ^= (unsigned int) len; h4 ^= (unsigned int) len;
+  h1 += h2; h1 += h3; h1 += h4;
+  h2 += h1; h3 += h1; h4 += h1;
+  IMPORT_CACHE_FMIX32(h1);
+  IMPORT_CACHE_FMIX32(h2);
+  IMPORT_CACHE_FMIX32(h3);
+  IMPORT_CACHE_FMIX32(h4);
+  h1 += h2; h1 += h3; h1 += h4;
+  h2 += h1; h3 += h1; h4 += h1;
+
+  return NewStringf("%08x%08x%08x%08x", h1 & 0xffffffff, h2 & 0xffffffff, h3 & 0xffffffff, h4 & 0xffffffff);
+}
+
+/* Digest of the raw contents of a file, 0 if it cannot be read */
+static String *import_cache_file_digest(const String *filename) {
+  String *contents;
+  String *digest;
+  char buffer[4096];
+  size_t nbytes;
+  FILE *f = fopen(Char(filename), "rb");
+  if (!f)
+    return 0;
+  contents = NewStringEmpty();
+  while ((nbytes = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+    Write(contents, buffer, (int) nbytes);
+  }
+  fclose(f);
+  digest = import_cache_digest(Char(contents), Len(contents));
+  Delete(contents);
+  return digest;
+}
+
+/* Write a length prefixed string, a null string has length -1 */
+static void import_cache_write_string(String *out, const String *s) {
+  if (s) {
+    Printf(out, "%d ", Len(s));
+    Append(out, s);
+    Putc('\n', out);
+  } else {
+    Append(out, "-1 \n");
+  }
+}
+
+static void import_cache_write_macro(String *out, Hash *macro) {
+  List *args = Getattr(macro, kpp_args);
+  int i;
+  import_cache_write_string(out, Getattr(macro, kpp_name));
+  import_cache_write_string(out, Getattr(macro, kpp_value));
+  import_cache_write_string(out, Getfile(macro));
+  Printf(out, "%d %d %d %d\n", Getline(macro), Getattr(macro, kpp_varargs) ? 1 : 0, Getattr(macro, kpp_swigmacro) ? 1 : 0, args ? Len(args) : -1);
+  for (i = 0; args && i < Len(args); i++) {
+    import_cache_write_string(out, Getitem(args, i));
+  }
+}
+
+static int import_cache_read_int(const char **p, const char *end, int *value) {
+  char *e;
+  long v;
+  if (*p >= end)
+    return 0;
+  v = strtol(*p, &e, 10);
+  if ((e == *p) || (e >= end) || ((*e != ' ') && (*e != '\n')))
+    return 0;
+  *value = (int) v;
+  *p = e + 1;
+  return 1;
+}
+
+static int import_cache_read_string(const char **p, const char *end, String **value) {
+  int len;
+  *value = 0;
+  if (!import_cache_read_int(p, end, &len))
+    return 0;
+  if (len < 0) {
+    if ((*p >= end) || (**p != '\n'))
+      return 0;
+    *p += 1;
+    return 1;
+  }
+  if ((end - *p <= len) || ((*p)[len] != '\n'))
+    return 0;
+  *value = NewStringWithSize(*p, len);
+  *p += len + 1;
+  return 1;
+}
+
+static Hash *import_cache_read_macro(const char **p, const char *end) {
+  String *name, *value, *file;
+  int line, varargs, swigmacro, nargs, i;
+  Hash *macro;
+  if (!import_cache_read_string(p, end, &name) || !name)
+    return 0;
+  macro = NewHash();
+  Setattr(macro, kpp_name, name);
+  Delete(name);
+  if (!import_cache_read_string(p, end, &value) || !value)
+    goto error;
+  Setattr(macro, kpp_value, value);
+  Delete(value);
+  if (!import_cache_read_string(p, end, &file))
+    goto error;
+  Setfile(macro, file);
+  Delete(file);
+  if (!import_cache_read_int(p, end, &line) || !import_cache_read_int(p, end, &varargs) || !import_cache_read_int(p, end, &swigmacro)
+      || !import_cache_read_int(p, end, &nargs))
+    goto error;
+  Setline(macro, line);
+  if (varargs)
+    Setattr(macro, kpp_varargs, "1");
+  if (swigmacro)
+    Setattr(macro, kpp_swigmacro, "1");
+  if (nargs >= 0) {
+    List *args = NewList();
+    Setattr(macro, kpp_args, args);
+    Delete(args);
+    for (i = 0; i < nargs; i++) {
+      String *arg;
+      if (!import_cache_read_string(p, end, &arg) || !arg)
+	goto error;
+      Append(args, arg);
+      Delete(arg);
+    }
+  }
+  return macro;
+
+error:
+  Delete(macro);
+  return 0;
+}
+
+/* Cache file name for the %import of the file with contents s */
+static String *import_cache_filename(String *s) {
+  Hash *symbols = Getattr(cpp, kpp_symbols);
+  String *key = NewStringEmpty();
+  List *paths = Swig_search_path();
+  List *names = Keys(symbols);
+  String *digest;
+  String *filename;
+  int i;
+
+  Printf(key, "SWIG %s\n", PACKAGE_VERSION);
+  import_cache_write_string(key, Getfile(s));
+  Printf(key, "%d %d %d %d %d\n", imported_depth, single_include, include_all, import_all, error_as_warning);
+  for (i = 0; i < Len(paths); i++)
+    import_cache_write_string(key, Getitem(paths, i));
+  SortList(names, 0);
+  for (i = 0; i < Len(names); i++)
+    import_cache_write_macro(key, Getattr(symbols, Getitem(names, i)));
+  import_cache_write_string(key, s);
+
+  digest = import_cache_digest(Char(key), Len(key));
+  filename = NewStringf("%s%s%s.swigpp", import_cache_dir, SWIG_FILE_DELIMITER, digest);
+  Delete(digest);
+  Delete(names);
+  Delete(paths);
+  Delete(key);
+  return filename;
+}
+
+/* Load a cache entry, applying its side effects and returning the preprocessed text, or 0 if it is not usable */
+static String *import_cache_load(String *filename) {
+  Hash *symbols = Getattr(cpp, kpp_symbols);
+  List *files = NewList();
+  List *macros = NewList();
+  List *undefs = NewList();
+  String *text = 0;
+  String *data;
+  const char *p, *end;
+  const char *header = "SWIG import cache " PACKAGE_VERSION "\n";
+  int i, n;
+  int ok = 0;
+  FILE *f = fopen(Char(filename), "rb");
+
+  if (!f)
+    goto done;
+  data = Swig_read_file(f);
+  fclose(f);
+  p = Char(data);
+  end = p + Len(data);
+  if (strncmp(p, header, strlen(header)) != 0)
+    goto bad;
+  p += strlen(header);
+
+  /* The included files must be unchanged and not yet included */
+  if (!import_cache_read_int(&p, end, &n))
+    goto bad;
+  for (i = 0; i < n; i++) {
+    String *file, *digest, *current;
+    int same;
+    if (!import_cache_read_string(&p, end, &file) || !file)
+      goto bad;
+    Append(files, file);
+    Delete(file);
+    if (!import_cache_read_string(&p, end, &digest) || !digest)
+      goto bad;
+    current = import_cache_file_digest(file);
+    same = current && Equal(current, digest);
+    Delete(current);
+    Delete(digest);
+    if (!same || (single_include && Getattr(included_files, file)))
+      goto bad;
+  }
+
+  /* The files that were not included again must still be included already */
+  if (!import_cache_read_int(&p, end, &n))
+    goto bad;
+  for (i = 0; i < n; i++) {
+    String *file;
+    int included;
+    if (!import_cache_read_string(&p, end, &file) || !file)
+      goto bad;
+    included = single_include && Getattr(included_files, file);
+    Delete(file);
+    if (!included)
+      goto bad;
+  }
+
+  if (!import_cache_read_int(&p, end, &n))
+    goto bad;
+  for (i = 0; i < n; i++) {
+    Hash *macro = import_cache_read_macro(&p, end);
+    if (!macro)
+      goto bad;
+    Append(macros, macro);
+    Delete(macro);
+  }
+  if (!import_cache_read_int(&p, end, &n))
+    goto bad;
+  for (i = 0; i < n; i++) {
+    String *name;
+    if (!import_cache_read_string(&p, end, &name) || !name)
+      goto bad;
+    Append(undefs, name);
+    Delete(name);
+  }
+  if (!import_cache_read_string(&p, end, &text) || !text)
+    goto bad;
+
+  /* All good, apply the side effects of preprocessing the file */
+  for (i = 0; i < Len(files); i++) {
+    String *file = Getitem(files, i);
+    if (single_include)
+      Setattr(included_files, file, file);
+    Append(dependencies, file);
+  }
+  for (i = 0; i < Len(macros); i++) {
+    Hash *macro = Getitem(macros, i);
+    Setattr(symbols, Getattr(macro, kpp_name), macro);
+  }
+  for (i = 0; i < Len(undefs); i++) {
+    Delattr(symbols, Getitem(undefs, i));
+  }
+  ok = 1;
+
+bad:
+  Delete(data);
+done:
+  Delete(files);
+  Delete(macros);
+  Delete(undefs);
+  if (!ok) {
+    Delete(text);
+    text = 0;
+  }
+  return text;
+}
+
+/* Store a cache entry for a file that has just been preprocessed */
+static void import_cache_store(String *filename, String *text, Hash *before) {
+  Hash *symbols = Getattr(cpp, kpp_symbols);
+  String *out = NewStringf("SWIG import cache %s\n", PACKAGE_VERSION);
+  String *tmpname;
+  List *defined = NewList();
+  List *undefined = NewList();
+  Iterator ki;
+  File *f;
+  int i;
+
+  Printf(out, "%d\n", Len(import_cache_files));
+  for (i = 0; i < Len(import_cache_files); i++) {
+    String *file = Getitem(import_cache_files, i);
+    String *digest = import_cache_file_digest(file);
+    if (!digest)
+      goto done;
+    import_cache_write_string(out, file);
+    import_cache_write_string(out, digest);
+    Delete(digest);
+  }
+  Printf(out, "%d\n", Len(import_cache_skipped));
+  for (i = 0; i < Len(import_cache_skipped); i++) {
+    import_cache_write_string(out, Getitem(import_cache_skipped, i));
+  }
+
+  /* Macros defined or undefined by the file */
+  for (ki = First(symbols); ki.key; ki = Next(ki)) {
+    if (Getattr(before, ki.key) != ki.item)
+      Append(defined, ki.item);
+  }
+  for (ki = First(before); ki.key; ki = Next(ki)) {
+    if (!Getattr(symbols, ki.key))
+      Append(undefined, ki.key);
+  }
+  Printf(out, "%d\n", Len(defined));
+  for (i = 0; i < Len(defined); i++) {
+    import_cache_write_macro(out, Getitem(defined, i));
+  }
+  Printf(out, "%d\n", Len(undefined));
+  for (i = 0; i < Len(undefined); i++) {
+    import_cache_write_string(out, Getitem(undefined, i));
+  }
+  import_cache_write_string(out, text);
+
+  /* Write to a temporary file and rename it so that concurrent SWIG runs never see a partial entry */
+  tmpname = NewStringf("%s.%d", filename, (int) getpid());
+  f = NewFile(tmpname, "wb", 0);
+  if (f) {
+    Write(f, Char(out), Len(out));
+    Delete(f);
+    if (rename(Char(tmpname), Char(filename)) != 0)
+      remove(Char(tmpname));
+  }
+  Delete(tmpname);
+
+done:
+  Delete(defined);
+  Delete(undefined);
+  Delete(out);
+}
+
+/* Preprocess the %import file s, using the %import cache if possible */
+static String *import_cache_parse(String *s) {
+  Hash *symbols = Getattr(cpp, kpp_symbols);
+  String *filename = import_cache_filename(s);
+  String *text = import_cache_load(filename);
+  if (!text) {
+    Hash *before = Copy(symbols);
+    int diagnostics = Swig_warn_issued_count() + Swig_error_count();
+    import_cache_recording = 1;
+    import_cache_nostore = 0;
+    import_cache_files = NewList();
+    import_cache_skipped = NewList();
+    text = Preprocessor_parse(s);
+    import_cache_recording = 0;
+    if (!import_cache_nostore && (diagnostics == Swig_warn_issued_count() + Swig_error_count()))
+      import_cache_store(filename, text, before);
+    Delete(import_cache_files);
+    Delete(import_cache_skipped);
+    import_cache_files = 0;
+    import_cache_skipped = 0;
+    Delete(before);
+  }
+  Delete(filename);
+  return text;
+}
+
 
 /* -----------------------------------------------------------------------------
  * Preprocessor_parse()
@@ -1800,6 +2260,7 @@ String *Preprocessor_parse(String *s) {
 	  while (*c && (isspace((int) *c)))
 	    c++;
 	  if (*c) {
+	    import_cache_nostore = 1;
 	    if (strncmp(c, "nowarn=", 7) == 0) {
 	      String *val = NewString(c + 7);
 	      String *nowarn = Preprocessor_replace(val);
@@ -1933,7 +2394,10 @@ String *Preprocessor_parse(String *s) {
 		Delslice(dirname, len - 1, len); /* Kill trailing directory delimiter */
 		Swig_push_directory(dirname);
 	      }
-	      s2 = Preprocessor_parse(s1);
+	      if (import_cache_dir && !import_cache_recording && Equal(decl, kpp_dimport))
+		s2 = import_cache_parse(s1);
+	      else
+		s2 = Preprocessor_parse(s1);
 	      if (dirname) {
 		Swig_pop_directory();
 	      }
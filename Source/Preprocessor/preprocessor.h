@@ -30,6 +30,7 @@ extern "C" {
   extern void Preprocessor_import_all(int);
   extern void Preprocessor_ignore_missing(int);
   extern void Preprocessor_error_as_warning(int);
+  extern void Preprocessor_import_cache(const_String_or_char_ptr dir);
   extern List *Preprocessor_depend(void);
   extern void Preprocessor_expr_init(void);
   extern void Preprocessor_expr_delete(void);
@@ -44,6 +44,7 @@ static int silence = 0;		/* Silent operation */
 static String *filter = 0;	/* Warning filter */
 static int warnall = 0;
 static int nwarning = 0;
+static int nwarning_issued = 0;	/* Including suppressed warnings */
 static int nerrors = 0;
 
 static int init_fmt = 0;
@@ -67,6 +68,7 @@ void Swig_warning(int wnum, const_String_or_char_ptr filename, int line, const c
   char *msg;
   int wrn = 1;
   va_list ap;
+  nwarning_issued++;
   if (silence)
     return;
   if (!init_fmt)
@@ -239,6 +241,17 @@ int Swig_warn_count(void) {
   return nwarning;
 }
 
+/* ----------------------------------------------------------------------------- 
+ * Swig_warn_issued_count()
+ *
+ * Return the number of warnings issued, including those that were not
+ * displayed because they were suppressed
+ * ----------------------------------------------------------------------------- */
+
+int Swig_warn_issued_count(void) {
+  return nwarning_issued;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_error_msg_format()
  *
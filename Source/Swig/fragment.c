@@ -86,7 +86,7 @@ char *char_index(char *str, char c) {
   return (c == *str) ? str : 0;
 }
 
-void Swig_fragment_emit(Node *n) {
+static void fragment_emit(Node *n) {
   String *code;
   char *pc, *tok;
   String *t;
@@ -138,7 +138,7 @@ void Swig_fragment_emit(Node *n) {
 	    Printf(stdout, "emitting fragment %s %s\n", nn, type);
 	  Setfile(nn, Getfile(n));
 	  Setline(nn, Getline(n));
-	  Swig_fragment_emit(nn);
+	  fragment_emit(nn);
 	}
 	nn = nextSibling(nn);
       }
@@ -166,7 +166,7 @@ void Swig_fragment_emit(Node *n) {
 	Append(name, mangle);
 	Setfile(name, Getfile(n));
 	Setline(name, Getline(n));
-	Swig_fragment_emit(name);
+	fragment_emit(name);
 	Delete(mangle);
 	Delete(name);
       }
@@ -186,3 +186,9 @@ void Swig_fragment_emit(Node *n) {
   }
   Delete(t);
 }
+
+void Swig_fragment_emit(Node *n) {
+  Swig_profile_begin("fragment:emit");
+  fragment_emit(n);
+  Swig_profile_end("fragment:emit");
+}
@@ -1425,6 +1425,33 @@ String *replace_captures(int num_captures, const char *input, String *subst, int
   return result;
 }
 
+static Hash *regex_cache = 0;
+
+/* -----------------------------------------------------------------------------
+ * Swig_regex_compile()
+ *
+ * Returns the compiled pcre for pattern.  Patterns are only compiled once, as
+ * the same pattern is usually matched against many names.  Returns 0 and sets
+ * error and errorpos if the pattern is invalid.
+ * ----------------------------------------------------------------------------- */
+
+void *Swig_regex_compile(String *pattern, const char **error, int *errorpos) {
+  pcre *compiled_pat;
+  DOH *cached;
+  if (!regex_cache)
+    regex_cache = NewHash();
+  cached = Getattr(regex_cache, pattern);
+  if (cached)
+    return Data(cached);
+  compiled_pat = pcre_compile(Char(pattern), 0, error, errorpos, NULL);
+  if (compiled_pat) {
+    cached = NewVoid(compiled_pat, pcre_free);
+    Setattr(regex_cache, pattern, cached);
+    Delete(cached);
+  }
+  return compiled_pat;
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_string_regex()
  *
@@ -1433,8 +1460,6 @@ String *replace_captures(int num_captures, const char *input, String *subst, int
  *   Printf(stderr,"gsl%(regex:/GSL_(.*)_/\\1/)s", "GSL_Hello_") -> gslHello
  * ----------------------------------------------------------------------------- */
 String *Swig_string_regex(String *s) {
-  const int pcre_options = 0;
-
   String *res = 0;
   pcre *compiled_pat = 0;
   const char *pcre_error, *input;
@@ -1445,8 +1470,7 @@ String *Swig_string_regex(String *s) {
   if (split_regex_pattern_subst(s, &pattern, &subst, &input)) {
     int rc;
 
-    compiled_pat = pcre_compile(
-          Char(pattern), pcre_options, &pcre_error, &pcre_errorpos, NULL);
+    compiled_pat = (pcre *) Swig_regex_compile(pattern, &pcre_error, &pcre_errorpos);
     if (!compiled_pat) {
       Swig_error("SWIG", Getline(s), "PCRE compilation failed: '%s' in '%s':%i.\n",
           pcre_error, Char(pattern), pcre_errorpos);
@@ -1464,7 +1488,6 @@ String *Swig_string_regex(String *s) {
 
   DohDelete(pattern);
   DohDelete(subst);
-  pcre_free(compiled_pat);
   return res ? res : NewStringEmpty();
 }
 
@@ -1504,6 +1527,8 @@ int Swig_is_generated_overload(Node *n) {
  * ----------------------------------------------------------------------------- */
 
 void Swig_init() {
+  Swig_keys_init();
+
   /* Set some useful string encoding methods */
   DohEncoding("escape", Swig_string_escape);
   DohEncoding("hexescape", Swig_string_hexescape);
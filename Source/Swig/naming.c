@@ -1100,7 +1100,7 @@ static int name_regexmatch_value(Node *n, String *pattern, String *s) {
   int errpos;
   int rc;
 
-  compiled_pat = pcre_compile(Char(pattern), 0, &err, &errpos, NULL);
+  compiled_pat = (pcre *) Swig_regex_compile(pattern, &err, &errpos);
   if (!compiled_pat) {
     Swig_error("SWIG", Getline(n),
                "Invalid regex \"%s\": compilation failed at %d: %s\n",
@@ -1109,7 +1109,6 @@ static int name_regexmatch_value(Node *n, String *pattern, String *s) {
   }
 
   rc = pcre_exec(compiled_pat, NULL, Char(s), Len(s), 0, 0, NULL, 0);
-  pcre_free(compiled_pat);
 
   if (rc == PCRE_ERROR_NOMATCH)
     return 0;
@@ -1196,6 +1195,195 @@ static int name_match_nameobj(Hash *rn, Node *n) {
   return match;
 }
 
+/* -----------------------------------------------------------------------------
+ * Rule index for name_nameobj_lget()
+ *
+ * The rules in a rename/namewarn list are tried newest first and the first one
+ * that matches is used.  Rather than trying every rule for every name, the rules
+ * are indexed when they are first looked up, in one of:
+ *
+ *   "names"     - rules with a plain target name, keyed by the target name
+ *   "fullnames" - as above, but for rules using the fullname option
+ *   "prefixes"  - rules without a target name and whose new name is a single
+ *                 %(regex:/^prefix.../.../)s expression, keyed by the literal
+ *                 prefix that the regex requires the name to start with
+ *   "others"    - all the other rules, which are tried for every name
+ *   "all"       - all the rules, used if there is no name
+ *
+ * Each of them holds the numbers of its rules in increasing order, the number
+ * of a rule being its position in the "rules" list, which has the oldest rule
+ * first.  The candidate rules for a name are tried from the highest number down,
+ * so that the result is the same as scanning the newest first rename/namewarn
+ * list.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *rename_index = 0;
+static Hash *namewarn_index = 0;
+
+#ifdef HAVE_PCRE
+static String *name_regex_literal_prefix(String *fmt) {
+  const char *c = Char(fmt);
+  const char *start;
+  const char *end;
+  size_t len = c ? strlen(c) : 0;
+  if (len < 13 || strncmp(c, "%(regex:/^", 10) != 0 || strcmp(c + len - 3, "/)s") != 0)
+    return 0;
+  /* Anything but a single regex with no alternatives is too hard to analyse */
+  if (strchr(c + 1, '%') || strchr(c, '|'))
+    return 0;
+  start = c + 10;
+  end = start;
+  while (isalnum((int) *end) || *end == '_')
+    end++;
+  /* The last character is optional if followed by one of these quantifiers */
+  if (end > start && (*end == '?' || *end == '*' || *end == '{'))
+    end--;
+  return end > start ? NewStringWithSize(start, (int)(end - start)) : 0;
+}
+#endif
+
+/* The numbers of the rules in an index bucket, in increasing order */
+typedef struct {
+  int *seqs;
+  int len;
+  int size;
+} RuleNumbers;
+
+/* Position in the rule numbers of a candidate bucket, which are tried from the end */
+typedef struct {
+  RuleNumbers *numbers;
+  int pos;
+} RuleCursor;
+
+static void name_rule_numbers_delete(void *ptr) {
+  RuleNumbers *numbers = (RuleNumbers *) ptr;
+  free(numbers->seqs);
+  free(numbers);
+}
+
+/* The rule numbers stored under key in h, created if necessary when create is set */
+static RuleNumbers *name_rule_numbers(Hash *h, const_String_or_char_ptr key, int create) {
+  DOH *v = Getattr(h, key);
+  if (!v) {
+    RuleNumbers *numbers;
+    if (!create)
+      return 0;
+    numbers = (RuleNumbers *) malloc(sizeof(RuleNumbers));
+    numbers->seqs = 0;
+    numbers->len = 0;
+    numbers->size = 0;
+    v = NewVoid(numbers, name_rule_numbers_delete);
+    Setattr(h, key, v);
+    Delete(v);
+  }
+  return (RuleNumbers *) Data(v);
+}
+
+static void name_rule_numbers_add(Hash *h, const_String_or_char_ptr key, int seq) {
+  RuleNumbers *numbers = name_rule_numbers(h, key, 1);
+  if (numbers->len == numbers->size) {
+    numbers->size = numbers->size ? numbers->size * 2 : 4;
+    numbers->seqs = (int *) realloc(numbers->seqs, numbers->size * sizeof(int));
+  }
+  numbers->seqs[numbers->len++] = seq;
+}
+
+static void name_rule_index_add(Hash *index, Hash *rn) {
+  List *rules = Getattr(index, "rules");
+  String *tname = Getattr(rn, "targetname");
+  int seq = Len(rules);
+  Append(rules, rn);
+  name_rule_numbers_add(index, "all", seq);
+  if (tname && !Getattr(rn, "sourcefmt") && !GetFlag(rn, "regextarget") && !Strchr(tname, '|')) {
+    name_rule_numbers_add(Getattr(index, GetFlag(rn, "fullname") ? "fullnames" : "names"), tname, seq);
+  } else {
+    String *prefix = 0;
+#ifdef HAVE_PCRE
+    if (!tname)
+      prefix = name_regex_literal_prefix(Getattr(rn, "name"));
+#endif
+    if (prefix) {
+      name_rule_numbers_add(Getattr(index, "prefixes"), prefix, seq);
+      if (Len(prefix) > GetInt(index, "maxprefix"))
+	SetInt(index, "maxprefix", Len(prefix));
+      Delete(prefix);
+    } else {
+      name_rule_numbers_add(index, "others", seq);
+    }
+  }
+}
+
+/* Bring the index up to date with the rules added to the front of namelist */
+static Hash *name_rule_index(Hash **indexp, List *namelist) {
+  Hash *index = *indexp;
+  int len = Len(namelist);
+  int count;
+  int i;
+  if (!index) {
+    Hash *h;
+    index = NewHash();
+    h = NewHash();
+    Setattr(index, "names", h);
+    Delete(h);
+    h = NewHash();
+    Setattr(index, "fullnames", h);
+    Delete(h);
+    h = NewHash();
+    Setattr(index, "prefixes", h);
+    Delete(h);
+    h = NewList();
+    Setattr(index, "rules", h);
+    Delete(h);
+    SetInt(index, "maxprefix", 0);
+    *indexp = index;
+  }
+  count = Len(Getattr(index, "rules"));
+  for (i = len - count - 1; i >= 0; i--) {
+    name_rule_index_add(index, Getitem(namelist, i));
+  }
+  return index;
+}
+
+/* Add a cursor for the rule numbers, if there are any, returning the number of cursors */
+static int name_rule_cursor_add(RuleCursor *cursors, int ncursors, RuleNumbers *numbers) {
+  if (numbers && numbers->len) {
+    cursors[ncursors].numbers = numbers;
+    cursors[ncursors].pos = numbers->len;
+    ncursors++;
+  }
+  return ncursors;
+}
+
+/* Cursors for the candidate rules for name, returning the number of cursors */
+static int name_rule_candidates(Hash *index, String *prefix, String *name, RuleCursor *cursors) {
+  int ncursors = 0;
+  int maxprefix = GetInt(index, "maxprefix");
+  Hash *fullnames = Getattr(index, "fullnames");
+  ncursors = name_rule_cursor_add(cursors, ncursors, name_rule_numbers(index, "others", 0));
+  ncursors = name_rule_cursor_add(cursors, ncursors, name_rule_numbers(Getattr(index, "names"), name, 0));
+  if (Len(fullnames)) {
+    if (prefix) {
+      String *pname = NewStringf("%s::%s", prefix, name);
+      ncursors = name_rule_cursor_add(cursors, ncursors, name_rule_numbers(fullnames, pname, 0));
+      Delete(pname);
+    } else {
+      ncursors = name_rule_cursor_add(cursors, ncursors, name_rule_numbers(fullnames, name, 0));
+    }
+  }
+  if (maxprefix > 0) {
+    Hash *prefixes = Getattr(index, "prefixes");
+    const char *c = Char(name);
+    int len = Len(name);
+    int i;
+    for (i = 1; i <= len && i <= maxprefix; i++) {
+      String *p = NewStringWithSize(c, i);
+      ncursors = name_rule_cursor_add(cursors, ncursors, name_rule_numbers(prefixes, p, 0));
+      Delete(p);
+    }
+  }
+  return ncursors;
+}
+
 /* -----------------------------------------------------------------------------
  * Hash *name_nameobj_lget()
  *
@@ -1203,15 +1391,37 @@ static int name_match_nameobj(Hash *rn, Node *n) {
  * 
  * ----------------------------------------------------------------------------- */
 
-static Hash *name_nameobj_lget(List *namelist, Node *n, String *prefix, String *name, String *decl) {
+static Hash *name_nameobj_lget(List *namelist, Hash **indexp, Node *n, String *prefix, String *name, String *decl) {
   Hash *res = 0;
   if (namelist) {
-    int len = Len(namelist);
+    Hash *index = name_rule_index(indexp, namelist);
+    RuleCursor *cursors = (RuleCursor *) malloc((3 + GetInt(index, "maxprefix")) * sizeof(RuleCursor));
+    int ncursors = 0;
     int i;
     int match = 0;
-    for (i = 0; !match && (i < len); i++) {
-      Hash *rn = Getitem(namelist, i);
-      String *rdecl = Getattr(rn, "decl");
+    if (name) {
+      ncursors = name_rule_candidates(index, prefix, name, cursors);
+    } else {
+      ncursors = name_rule_cursor_add(cursors, ncursors, name_rule_numbers(index, "all", 0));
+    }
+    while (!match) {
+      Hash *rn = 0;
+      String *rdecl;
+      RuleCursor *best = 0;
+      int bestseq = -1;
+      /* The next rule is the newest of the rules at the cursors */
+      for (i = 0; i < ncursors; i++) {
+	RuleCursor *cursor = &cursors[i];
+	if (cursor->pos > 0 && cursor->numbers->seqs[cursor->pos - 1] > bestseq) {
+	  best = cursor;
+	  bestseq = cursor->numbers->seqs[cursor->pos - 1];
+	}
+      }
+      if (!best)
+	break;
+      best->pos--;
+      rn = Getitem(Getattr(index, "rules"), bestseq);
+      rdecl = Getattr(rn, "decl");
       if (rdecl && (!decl || !Equal(rdecl, decl))) {
 	continue;
       } else if (name_match_nameobj(rn, n)) {
@@ -1255,6 +1465,7 @@ static Hash *name_nameobj_lget(List *namelist, Node *n, String *prefix, String *
 	break;
       }
     }
+    free(cursors);
   }
   return res;
 }
@@ -1300,7 +1511,7 @@ static Hash *name_namewarn_get(Node *n, String *prefix, String *name, SwigType *
     if (wrn && !name_match_nameobj(wrn, n))
       wrn = 0;
     if (!wrn) {
-      wrn = name_nameobj_lget(name_namewarn_list(), n, prefix, name, decl);
+      wrn = name_nameobj_lget(name_namewarn_list(), &namewarn_index, n, prefix, name, decl);
     }
     if (wrn && Getattr(wrn, "error")) {
       if (n) {
@@ -1463,7 +1674,7 @@ String *Swig_name_make(Node *n, String *prefix, const_String_or_char_ptr cname,
   if (rename_hash || rename_list || namewarn_hash || namewarn_list) {
     Hash *rn = Swig_name_object_get(name_rename_hash(), prefix, name, decl);
     if (!rn || !name_match_nameobj(rn, n)) {
-      rn = name_nameobj_lget(name_rename_list(), n, prefix, name, decl);
+      rn = name_nameobj_lget(name_rename_list(), &rename_index, n, prefix, name, decl);
       if (rn) {
 	String *sfmt = Getattr(rn, "sourcefmt");
 	int fullname = GetFlag(rn, "fullname");
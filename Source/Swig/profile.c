@@ -0,0 +1,345 @@
+/* -----------------------------------------------------------------------------
+ * This file is part of SWIG, which is licensed as a whole under version 3
+ * (or any later version) of the GNU General Public License. Some additional
+ * terms also apply to certain portions of SWIG. The full details of the SWIG
+ * license and copyrights can be found in the LICENSE and COPYRIGHT files
+ * included with the SWIG source code as distributed by the SWIG developers
+ * and at http://www.swig.org/legal.html.
+ *
+ * profile.c
+ *
+ * Timing of the SWIG processing for the -profile option.
+ *
+ * Code to be timed is bracketed by Swig_profile_begin() and Swig_profile_end()
+ * calls naming a section, for example "phase:parse" or
+ * "handler:functionWrapper".  Sections nest, so for each section the report
+ * gives the total time spent in it and its self time, that is the time not
+ * spent in any nested section.  A section that is re-entered, for example by
+ * a recursive call, is only counted once in the total time.
+ *
+ * Swig_profile_decl_begin() and Swig_profile_decl_end() attribute the time
+ * spent wrapping the outermost declarations to the declaration and to the
+ * file it is in, so that the most expensive declarations and files can be
+ * reported.
+ * ----------------------------------------------------------------------------- */
+
+#include "swig.h"
+#include <time.h>
+
+#define PROFILE_TOP_N 20
+
+typedef struct {
+  const char *name;
+  int calls;
+  int active;			/* Nesting depth of the section */
+  double total;
+  double self;
+} SectionTime;
+
+typedef struct {
+  int section;
+  double start;
+  double children;		/* Time spent in nested sections */
+} SectionFrame;
+
+typedef struct {
+  String *name;
+  String *file;
+  int line;
+  double time;
+} ItemTime;
+
+static int profile_enabled = 0;
+static int profile_json = 0;
+static double profile_start = 0;
+
+static SectionTime *sections = 0;
+static int nsections = 0;
+static int maxsections = 0;
+
+static SectionFrame *stack = 0;
+static int stack_depth = 0;
+static int stack_max = 0;
+
+/* Declarations and files, the hashes map a key to the index of the item */
+static Hash *decl_index = 0;
+static ItemTime *decls = 0;
+static int ndecls = 0;
+static int maxdecls = 0;
+static Hash *file_index = 0;
+static ItemTime *files = 0;
+static int nfiles = 0;
+static int maxfiles = 0;
+static int decl_depth = 0;
+static double decl_start = 0;
+
+/* Grow an array, exiting if there is no memory */
+static void *profile_realloc(void *ptr, size_t size) {
+  void *p = DohRealloc(ptr, size);
+  if (!p) {
+    Printf(stderr, "Out of memory\n");
+    SWIG_exit(EXIT_FAILURE);
+  }
+  return p;
+}
+
+static double profile_time(void) {
+  return (double) clock() / CLOCKS_PER_SEC;
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_profile_enable()
+ *
+ * Turn on profiling, the report is displayed as JSON if json is set.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_profile_enable(int json) {
+  profile_enabled = 1;
+  profile_json = json;
+  profile_start = profile_time();
+}
+
+int Swig_profile_enabled(void) {
+  return profile_enabled;
+}
+
+static int find_section(const char *name) {
+  int i;
+  /* Section names are usually string literals, so try the pointer first */
+  for (i = 0; i < nsections; i++) {
+    if (sections[i].name == name)
+      return i;
+  }
+  for (i = 0; i < nsections; i++) {
+    if (strcmp(sections[i].name, name) == 0)
+      return i;
+  }
+  if (nsections == maxsections) {
+    maxsections = maxsections ? 2 * maxsections : 64;
+    sections = (SectionTime *) profile_realloc(sections, maxsections * sizeof(SectionTime));
+  }
+  sections[nsections].name = name;
+  sections[nsections].calls = 0;
+  sections[nsections].active = 0;
+  sections[nsections].total = 0;
+  sections[nsections].self = 0;
+  return nsections++;
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_profile_begin()
+ *
+ * Start timing the section name, which must remain valid until the report is
+ * displayed.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_profile_begin(const char *name) {
+  SectionFrame *frame;
+  if (!profile_enabled)
+    return;
+  if (stack_depth == stack_max) {
+    stack_max = stack_max ? 2 * stack_max : 64;
+    stack = (SectionFrame *) profile_realloc(stack, stack_max * sizeof(SectionFrame));
+  }
+  frame = &stack[stack_depth++];
+  frame->section = find_section(name);
+  frame->children = 0;
+  sections[frame->section].calls++;
+  sections[frame->section].active++;
+  frame->start = profile_time();
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_profile_end()
+ *
+ * Stop timing the section name started by the matching Swig_profile_begin().
+ * ----------------------------------------------------------------------------- */
+
+void Swig_profile_end(const char *name) {
+  SectionFrame *frame;
+  SectionTime *section;
+  double elapsed;
+  if (!profile_enabled)
+    return;
+  assert(stack_depth > 0);
+  frame = &stack[--stack_depth];
+  section = &sections[frame->section];
+  assert(strcmp(section->name, name) == 0);
+  (void)name;
+  elapsed = profile_time() - frame->start;
+  section->self += elapsed - frame->children;
+  if (--section->active == 0)
+    section->total += elapsed;
+  if (stack_depth > 0)
+    stack[stack_depth - 1].children += elapsed;
+}
+
+static int add_item(Hash *index, ItemTime **items, int *nitems, int *maxitems, String *key, String *name, String *file, int line) {
+  String *idx = Getattr(index, key);
+  ItemTime *item;
+  if (idx)
+    return atoi(Char(idx));
+  if (*nitems == *maxitems) {
+    *maxitems = *maxitems ? 2 * *maxitems : 256;
+    *items = (ItemTime *) profile_realloc(*items, *maxitems * sizeof(ItemTime));
+  }
+  item = &(*items)[*nitems];
+  item->name = Copy(name);
+  item->file = Copy(file);
+  item->line = line;
+  item->time = 0;
+  idx = NewStringf("%d", *nitems);
+  Setattr(index, key, idx);
+  Delete(idx);
+  return (*nitems)++;
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_profile_decl_begin()
+ * Swig_profile_decl_end()
+ *
+ * Bracket the wrapping of the declaration n. Only the time of the outermost
+ * declaration is recorded, so that the time of a class includes its members.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_profile_decl_begin(Node *n) {
+  (void)n;
+  if (profile_enabled && decl_depth++ == 0)
+    decl_start = profile_time();
+}
+
+void Swig_profile_decl_end(Node *n) {
+  double elapsed;
+  String *name;
+  String *file;
+  String *key;
+  int line;
+  int i;
+  if (!profile_enabled || --decl_depth > 0)
+    return;
+  elapsed = profile_time() - decl_start;
+  if (!decl_index) {
+    decl_index = NewHash();
+    file_index = NewHash();
+  }
+  file = Getfile(n);
+  line = Getline(n);
+  if (!file)
+    file = NewStringEmpty();
+  else
+    file = Copy(file);
+  name = Getattr(n, "name");
+  name = name ? SwigType_namestr(name) : NewStringEmpty();
+  Insert(name, 0, " ");
+  Insert(name, 0, nodeType(n));
+  key = NewStringf("%s:%d:%s", file, line, name);
+  i = add_item(decl_index, &decls, &ndecls, &maxdecls, key, name, file, line);
+  decls[i].time += elapsed;
+  i = add_item(file_index, &files, &nfiles, &maxfiles, file, file, file, 0);
+  files[i].time += elapsed;
+  Delete(key);
+  Delete(name);
+  Delete(file);
+}
+
+static int compare_sections(const void *a, const void *b) {
+  const SectionTime *sa = (const SectionTime *) a;
+  const SectionTime *sb = (const SectionTime *) b;
+  if (sa->total != sb->total)
+    return sa->total < sb->total ? 1 : -1;
+  return strcmp(sa->name, sb->name);
+}
+
+static int compare_items(const void *a, const void *b) {
+  const ItemTime *ia = (const ItemTime *) a;
+  const ItemTime *ib = (const ItemTime *) b;
+  if (ia->time != ib->time)
+    return ia->time < ib->time ? 1 : -1;
+  return Cmp(ia->name, ib->name);
+}
+
+/* Write s as a JSON string */
+static void json_string(File *out, const_String_or_char_ptr s) {
+  const char *c = Char(s);
+  Putc('"', out);
+  for (; *c; c++) {
+    if (*c == '"' || *c == '\\')
+      Printf(out, "\\%c", *c);
+    else if ((unsigned char) *c < 0x20)
+      Printf(out, "\\u%04x", (unsigned char) *c);
+    else
+      Putc(*c, out);
+  }
+  Putc('"', out);
+}
+
+static void report_text(File *out, double total) {
+  int i;
+  Printf(out, "---[ profile ]---------------------------------------------------------------\n");
+  Printf(out, "Total time: %.3f s\n\n", total);
+  Printf(out, "%-40s %10s %10s %10s\n", "Section", "Calls", "Total (s)", "Self (s)");
+  for (i = 0; i < nsections; i++) {
+    Printf(out, "%-40s %10d %10.3f %10.3f\n", sections[i].name, sections[i].calls, sections[i].total, sections[i].self);
+  }
+  if (ndecls) {
+    Printf(out, "\nMost expensive declarations:\n");
+    Printf(out, "%10s  %s\n", "Time (s)", "Declaration");
+    for (i = 0; i < ndecls && i < PROFILE_TOP_N; i++) {
+      Printf(out, "%10.3f  %s (%s:%d)\n", decls[i].time, decls[i].name, decls[i].file, decls[i].line);
+    }
+  }
+  if (nfiles) {
+    Printf(out, "\nMost expensive files:\n");
+    Printf(out, "%10s  %s\n", "Time (s)", "File");
+    for (i = 0; i < nfiles && i < PROFILE_TOP_N; i++) {
+      Printf(out, "%10.3f  %s\n", files[i].time, files[i].file);
+    }
+  }
+  Printf(out, "-----------------------------------------------------------------------------\n");
+}
+
+static void report_json(File *out, double total) {
+  int i;
+  Printf(out, "{\n  \"total\": %.6f,\n  \"sections\": [", total);
+  for (i = 0; i < nsections; i++) {
+    Printf(out, "%s\n    {\"name\": ", i ? "," : "");
+    json_string(out, sections[i].name);
+    Printf(out, ", \"calls\": %d, \"total\": %.6f, \"self\": %.6f}", sections[i].calls, sections[i].total, sections[i].self);
+  }
+  Printf(out, "\n  ],\n  \"declarations\": [");
+  for (i = 0; i < ndecls && i < PROFILE_TOP_N; i++) {
+    Printf(out, "%s\n    {\"name\": ", i ? "," : "");
+    json_string(out, decls[i].name);
+    Printf(out, ", \"file\": ");
+    json_string(out, decls[i].file);
+    Printf(out, ", \"line\": %d, \"time\": %.6f}", decls[i].line, decls[i].time);
+  }
+  Printf(out, "\n  ],\n  \"files\": [");
+  for (i = 0; i < nfiles && i < PROFILE_TOP_N; i++) {
+    Printf(out, "%s\n    {\"file\": ", i ? "," : "");
+    json_string(out, files[i].file);
+    Printf(out, ", \"time\": %.6f}", files[i].time);
+  }
+  Printf(out, "\n  ]\n}\n");
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_profile_report()
+ *
+ * Display the timings of the sections, sorted by total time, followed by the
+ * most expensive declarations and files.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_profile_report(File *out) {
+  double total;
+  if (!profile_enabled)
+    return;
+  total = profile_time() - profile_start;
+  qsort(sections, nsections, sizeof(SectionTime), compare_sections);
+  qsort(decls, ndecls, sizeof(ItemTime), compare_items);
+  qsort(files, nfiles, sizeof(ItemTime), compare_items);
+  if (profile_json)
+    report_json(out, total);
+  else
+    report_text(out, total);
+}
@@ -203,6 +203,8 @@ extern "C" {
   extern Typetab *SwigType_pop_scope(void);
   extern Typetab *SwigType_set_scope(Typetab *h);
   extern void SwigType_print_scope(void);
+  extern void SwigType_typedef_cache_debug(void);
+  extern Hash *SwigType_scope_cache(const_String_or_char_ptr name);
   extern SwigType *SwigType_typedef_resolve(const SwigType *t);
   extern SwigType *SwigType_typedef_resolve_all(const SwigType *t);
   extern SwigType *SwigType_typedef_qualified(const SwigType *t);
@@ -263,6 +265,7 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
 
 /* --- Parse tree support --- */
 
+#include "swigkeys.h"
 #include "swigtree.h"
 
 /* -- Wrapper function Object */
@@ -335,6 +338,7 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern String *Swig_string_title(String *s);
   extern void Swig_offset_string(String *s, int number);
   extern String *Swig_pcre_version(void);
+  extern void *Swig_regex_compile(String *pattern, const char **error, int *errorpos);
   extern void Swig_init(void);
 
   extern int Swig_value_wrapper_mode(int mode);
@@ -349,6 +353,7 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern void Swig_warnfilter(const_String_or_char_ptr wlist, int val);
   extern void Swig_warnall(void);
   extern int Swig_warn_count(void);
+  extern int Swig_warn_issued_count(void);
   extern void Swig_error_msg_format(ErrorMessageFormat format);
   extern void Swig_diagnostic(const_String_or_char_ptr filename, int line, const char *fmt, ...);
   extern String *Swig_stringify_with_location(DOH *object);
@@ -410,6 +415,9 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern void Swig_typemap_search_debug_set(void);
   extern void Swig_typemap_used_debug_set(void);
   extern void Swig_typemap_register_debug_set(void);
+  extern void Swig_typemap_search_cache_flush(void);
+  extern void Swig_typemap_search_cache_symtab_changed(void);
+  extern void Swig_typemap_search_cache_debug(void);
 
   extern String *Swig_typemap_lookup(const_String_or_char_ptr tmap_method, Node *n, const_String_or_char_ptr lname, Wrapper *f);
   extern String *Swig_typemap_lookup_out(const_String_or_char_ptr tmap_method, Node *n, const_String_or_char_ptr lname, Wrapper *f, String *actioncode);
@@ -422,6 +430,16 @@ extern int        ParmList_is_compactdefargs(ParmList *p);
   extern void Swig_fragment_emit(String *name);
   extern void Swig_fragment_clear(String *section);
 
+/* --- Profiling --- */
+
+  extern void Swig_profile_enable(int json);
+  extern int Swig_profile_enabled(void);
+  extern void Swig_profile_begin(const char *name);
+  extern void Swig_profile_end(const char *name);
+  extern void Swig_profile_decl_begin(Node *n);
+  extern void Swig_profile_decl_end(Node *n);
+  extern void Swig_profile_report(File *out);
+
 /* --- Extension support --- */
 
   extern Hash *Swig_extend_hash(void);
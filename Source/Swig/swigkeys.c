@@ -0,0 +1,81 @@
+/* ----------------------------------------------------------------------------- 
+ * This file is part of SWIG, which is licensed as a whole under version 3 
+ * (or any later version) of the GNU General Public License. Some additional
+ * terms also apply to certain portions of SWIG. The full details of the SWIG
+ * license and copyrights can be found in the LICENSE and COPYRIGHT files
+ * included with the SWIG source code as distributed by the SWIG developers
+ * and at http://www.swig.org/legal.html.
+ *
+ * swigkeys.c
+ *
+ * Pre-interned parse tree attribute keys for the most frequently accessed
+ * attributes.
+ * ----------------------------------------------------------------------------- */
+
+#include "swig.h"
+
+String *k_access = 0;
+String *k_code = 0;
+String *k_decl = 0;
+String *k_defaultargs = 0;
+String *k_emitinput = 0;
+String *k_firstchild = 0;
+String *k_kind = 0;
+String *k_lastchild = 0;
+String *k_lname = 0;
+String *k_name = 0;
+String *k_nextsibling = 0;
+String *k_nodetype = 0;
+String *k_parentnode = 0;
+String *k_parms = 0;
+String *k_previoussibling = 0;
+String *k_storage = 0;
+String *k_symname = 0;
+String *k_symnextsibling = 0;
+String *k_symoverloaded = 0;
+String *k_symovername = 0;
+String *k_symsymtab = 0;
+String *k_tmapin = 0;
+String *k_tmapinnext = 0;
+String *k_type = 0;
+String *k_value = 0;
+String *k_wrapname = 0;
+
+/* -----------------------------------------------------------------------------
+ * Swig_keys_init()
+ *
+ * Intern the well known attribute keys.  The interned Strings are the same
+ * objects that Getattr() and Setattr() use for the equivalent C string keys.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_keys_init(void) {
+  if (k_name)
+    return;
+
+  k_access = InternKey("access");
+  k_code = InternKey("code");
+  k_decl = InternKey("decl");
+  k_defaultargs = InternKey("defaultargs");
+  k_emitinput = InternKey("emit:input");
+  k_firstchild = InternKey("firstChild");
+  k_kind = InternKey("kind");
+  k_lastchild = InternKey("lastChild");
+  k_lname = InternKey("lname");
+  k_name = InternKey("name");
+  k_nextsibling = InternKey("nextSibling");
+  k_nodetype = InternKey("nodeType");
+  k_parentnode = InternKey("parentNode");
+  k_parms = InternKey("parms");
+  k_previoussibling = InternKey("previousSibling");
+  k_storage = InternKey("storage");
+  k_symname = InternKey("sym:name");
+  k_symnextsibling = InternKey("sym:nextSibling");
+  k_symoverloaded = InternKey("sym:overloaded");
+  k_symovername = InternKey("sym:overname");
+  k_symsymtab = InternKey("sym:symtab");
+  k_tmapin = InternKey("tmap:in");
+  k_tmapinnext = InternKey("tmap:in:next");
+  k_type = InternKey("type");
+  k_value = InternKey("value");
+  k_wrapname = InternKey("wrap:name");
+}
@@ -0,0 +1,43 @@
+/* ----------------------------------------------------------------------------- 
+ * This file is part of SWIG, which is licensed as a whole under version 3 
+ * (or any later version) of the GNU General Public License. Some additional
+ * terms also apply to certain portions of SWIG. The full details of the SWIG
+ * license and copyrights can be found in the LICENSE and COPYRIGHT files
+ * included with the SWIG source code as distributed by the SWIG developers
+ * and at http://www.swig.org/legal.html.
+ *
+ * swigkeys.h
+ *
+ * Pre-interned parse tree attribute keys.  Using k_name instead of "name" in
+ * Getattr()/Setattr() skips the C string key lookup.  The keys are set up by
+ * Swig_keys_init() which is called from Swig_init().
+ * ----------------------------------------------------------------------------- */
+
+extern void Swig_keys_init(void);
+
+extern String *k_access;
+extern String *k_code;
+extern String *k_decl;
+extern String *k_defaultargs;
+extern String *k_emitinput;
+extern String *k_firstchild;
+extern String *k_kind;
+extern String *k_lastchild;
+extern String *k_lname;
+extern String *k_name;
+extern String *k_nextsibling;
+extern String *k_nodetype;
+extern String *k_parentnode;
+extern String *k_parms;
+extern String *k_previoussibling;
+extern String *k_storage;
+extern String *k_symname;
+extern String *k_symnextsibling;
+extern String *k_symoverloaded;
+extern String *k_symovername;
+extern String *k_symsymtab;
+extern String *k_tmapin;
+extern String *k_tmapinnext;
+extern String *k_type;
+extern String *k_value;
+extern String *k_wrapname;
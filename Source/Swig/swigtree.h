@@ -15,21 +15,21 @@
 
 /* Macros to traverse the DOM tree */
 
-#define  nodeType(x)               Getattr(x,"nodeType")
-#define  parentNode(x)             Getattr(x,"parentNode")
-#define  previousSibling(x)        Getattr(x,"previousSibling")
-#define  nextSibling(x)            Getattr(x,"nextSibling")
-#define  firstChild(x)             Getattr(x,"firstChild")
-#define  lastChild(x)              Getattr(x,"lastChild")
+#define  nodeType(x)               Getattr(x,k_nodetype)
+#define  parentNode(x)             Getattr(x,k_parentnode)
+#define  previousSibling(x)        Getattr(x,k_previoussibling)
+#define  nextSibling(x)            Getattr(x,k_nextsibling)
+#define  firstChild(x)             Getattr(x,k_firstchild)
+#define  lastChild(x)              Getattr(x,k_lastchild)
 
 /* Macros to set up the DOM tree (mostly used by the parser) */
 
-#define  set_nodeType(x,v)         Setattr(x,"nodeType",v)
-#define  set_parentNode(x,v)       Setattr(x,"parentNode",v)
-#define  set_previousSibling(x,v)  Setattr(x,"previousSibling",v)
-#define  set_nextSibling(x,v)      Setattr(x,"nextSibling",v)
-#define  set_firstChild(x,v)       Setattr(x,"firstChild",v)
-#define  set_lastChild(x,v)        Setattr(x,"lastChild",v)
+#define  set_nodeType(x,v)         Setattr(x,k_nodetype,v)
+#define  set_parentNode(x,v)       Setattr(x,k_parentnode,v)
+#define  set_previousSibling(x,v)  Setattr(x,k_previoussibling,v)
+#define  set_nextSibling(x,v)      Setattr(x,k_nextsibling,v)
+#define  set_firstChild(x,v)       Setattr(x,k_firstchild,v)
+#define  set_lastChild(x,v)        Setattr(x,k_lastchild,v)
 
 /* Utility functions */
 
@@ -310,6 +310,7 @@ void Swig_symbol_setscopename(const_String_or_char_ptr name) {
   /* Save a reference to this scope */
   Setattr(symtabs, qname, current_symtab);
   Delete(qname);
+  Swig_typemap_search_cache_symtab_changed();
 }
 
 /* -----------------------------------------------------------------------------
@@ -413,6 +414,7 @@ Symtab *Swig_symbol_newscope(void) {
   Setattr(h, "csymtab", ccurrent);
   Delete(ccurrent);
   current_symtab = h;
+  Swig_typemap_search_cache_symtab_changed();
   return h;
 }
 
@@ -519,6 +521,7 @@ void Swig_symbol_inherit(Symtab *s) {
       return;			/* Already inherited */
   }
   Append(inherit, s);
+  Swig_typemap_search_cache_symtab_changed();
 }
 
 /* -----------------------------------------------------------------------------
@@ -549,6 +552,8 @@ void Swig_symbol_cadd(const_String_or_char_ptr name, Node *n) {
   if (!name)
     return;
 
+  Swig_typemap_search_cache_symtab_changed();
+
   if (SwigType_istemplate(name)) {
     String *cname = NewString(name);
     String *dname = Swig_symbol_template_deftype(cname, 0);
@@ -61,6 +61,34 @@ static void replace_embedded_typemap(String *s, ParmList *parm_sublist, Wrapper
 
 static Hash *typemaps;
 
+/* -----------------------------------------------------------------------------
+ * The typemap search cache
+ *
+ * typemap_search() is called with the same typemap method, type and name many
+ * times over, for example "in" for r.q(const).std::string on every wrapper
+ * taking a const std::string &. The result of a search depends only on the
+ * registered typemaps, the typedefs and the symbols visible from the current
+ * scope, so search results (including failed searches) are cached keyed by
+ * method, type, name, qualified name and the current symbol table.
+ *
+ * The results are kept in the "typemap" cache of the current type scope, see
+ * SwigType_scope_cache(), which is discarded when a typedef it depends on
+ * changes.  Adding or removing a typemap calls Swig_typemap_search_cache_flush()
+ * which starts a new generation of results, and the caches of the scopes holding
+ * an older generation are emptied when next used.  Only the searches for a
+ * template type look up symbols, so only their results are discarded when a
+ * symbol is added, see Swig_typemap_search_cache_symtab_changed().  A search
+ * issuing a warning or an error is not cached, so that repeating the search
+ * repeats the message.
+ * ----------------------------------------------------------------------------- */
+
+static int typemap_search_generation = 1;
+static int typemap_search_symtab_generation = 1;
+static int typemap_search_symtab_used = 0;
+static int typemap_search_cache_hits = 0;
+static int typemap_search_cache_misses = 0;
+static int typemap_search_cache_flushes = 0;
+
 /* -----------------------------------------------------------------------------
  * typemap_identifier_fix()
  *
@@ -102,6 +130,7 @@ static Hash *get_typemap(const SwigType *type) {
     dtype = Swig_symbol_type_qualify(ty, 0);
     type = dtype;
     Delete(ty);
+    typemap_search_symtab_used = 1;
   }
 
   /* remove unary scope operator (::) prefix indicating global scope for looking up in the hashmap */
@@ -153,6 +182,30 @@ static void set_typemap(const SwigType *type, Hash **tmhash) {
 
 void Swig_typemap_init() {
   typemaps = NewHash();
+  Swig_typemap_search_cache_flush();
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_typemap_search_cache_flush()
+ *
+ * Discard all cached typemap search results. Must be called whenever the
+ * registered typemaps change.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_typemap_search_cache_flush(void) {
+  typemap_search_generation++;
+  typemap_search_cache_flushes++;
+}
+
+/* -----------------------------------------------------------------------------
+ * Swig_typemap_search_cache_symtab_changed()
+ *
+ * Discard the cached typemap search results that looked up symbols. Must be
+ * called whenever a symbol or symbol table is added.
+ * ----------------------------------------------------------------------------- */
+
+void Swig_typemap_search_cache_symtab_changed(void) {
+  typemap_search_symtab_generation++;
 }
 
 static String *typemap_method_name(const_String_or_char_ptr tmap_method) {
@@ -199,6 +252,8 @@ static void typemap_register(const_String_or_char_ptr tmap_method, ParmList *par
   if (!parms)
     return;
 
+  Swig_typemap_search_cache_flush();
+
   if (typemap_register_debug) {
       Printf(stdout, "Registering - %s\n", tmap_method);
       Swig_print_node(parms);
@@ -339,6 +394,7 @@ int Swig_typemap_copy(const_String_or_char_ptr tmap_method, ParmList *srcparms,
   if (ParmList_len(parms) != ParmList_len(srcparms))
     return -1;
 
+  Swig_typemap_search_cache_flush();
   tm_method = typemap_method_name(tmap_method);
   p = srcparms;
   tm_methods = NewString(tm_method);
@@ -395,6 +451,8 @@ void Swig_typemap_clear(const_String_or_char_ptr tmap_method, ParmList *parms) {
   String *multi_tmap_method;
   Hash *tm = 0;
 
+  Swig_typemap_search_cache_flush();
+
   /* This might not work */
   multi_tmap_method = NewString(tmap_method);
   p = parms;
@@ -448,6 +506,8 @@ int Swig_typemap_apply(ParmList *src, ParmList *dest) {
 
   /*  Printf(stdout,"apply : %s --> %s\n", ParmList_str(src), ParmList_str(dest)); */
 
+  Swig_typemap_search_cache_flush();
+
   /* Create type signature of source */
   ssig = NewStringEmpty();
   dsig = NewStringEmpty();
@@ -577,6 +637,8 @@ void Swig_typemap_clear_apply(Parm *parms) {
   Hash *tm;
   String *name;
 
+  Swig_typemap_search_cache_flush();
+
   /* Create a type signature of the parameters */
   tsig = NewStringEmpty();
   p = parms;
@@ -690,14 +752,14 @@ ret_result:
 }
 
 /* -----------------------------------------------------------------------------
- * typemap_search()
+ * typemap_search_uncached()
  *
  * Search for a typemap match. This is where the typemap pattern matching rules 
  * are implemented... tries to find the most specific typemap that includes a 
  * 'code' attribute.
  * ----------------------------------------------------------------------------- */
 
-static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type, const_String_or_char_ptr name, const_String_or_char_ptr qualifiedname, SwigType **matchtype, Node *node) {
+static Hash *typemap_search_uncached(const_String_or_char_ptr tmap_method, SwigType *type, const_String_or_char_ptr name, const_String_or_char_ptr qualifiedname, SwigType **matchtype, Node *node) {
   Hash *result = 0;
   Hash *tm;
   Hash *backup = 0;
@@ -807,6 +869,68 @@ ret_result:
   return result;
 }
 
+/* -----------------------------------------------------------------------------
+ * typemap_search()
+ *
+ * Search for a typemap match using the typemap search cache. The search is
+ * always done afresh when typemap search debugging is on so that the search
+ * steps are displayed.
+ * ----------------------------------------------------------------------------- */
+
+static Hash *typemap_search(const_String_or_char_ptr tmap_method, SwigType *type, const_String_or_char_ptr name, const_String_or_char_ptr qualifiedname, SwigType **matchtype, Node *node) {
+  Hash *result;
+  Hash *cache;
+  Hash *entry;
+  String *key;
+
+  if (typemap_search_debug)
+    return typemap_search_uncached(tmap_method, type, name, qualifiedname, matchtype, node);
+
+  cache = SwigType_scope_cache("typemap");
+  if (GetInt(cache, "generation") != typemap_search_generation) {
+    Clear(cache);
+    SetInt(cache, "generation", typemap_search_generation);
+  }
+
+  /* newlines cannot appear in any of the key components */
+  key = NewStringf("%p\n%s\n%s\n%s\n%s", Swig_symbol_current(), tmap_method, type, name ? name : "", qualifiedname ? qualifiedname : "");
+  entry = Getattr(cache, key);
+  if (entry && Getattr(entry, "symtab_generation") && GetInt(entry, "symtab_generation") != typemap_search_symtab_generation)
+    entry = 0;
+  if (entry) {
+    typemap_search_cache_hits++;
+    result = Getattr(entry, "typemap");
+    if (matchtype)
+      *matchtype = Copy(Getattr(entry, "matchtype"));
+  } else {
+    SwigType *mtype = 0;
+    int symtab_used = typemap_search_symtab_used;
+    int warnings = Swig_warn_issued_count();
+    int errors = Swig_error_count();
+    typemap_search_cache_misses++;
+    typemap_search_symtab_used = 0;
+    result = typemap_search_uncached(tmap_method, type, name, qualifiedname, &mtype, node);
+    if (warnings == Swig_warn_issued_count() && errors == Swig_error_count()) {
+      entry = NewHash();
+      if (result)
+	Setattr(entry, "typemap", result);
+      if (mtype)
+	Setattr(entry, "matchtype", mtype);
+      if (typemap_search_symtab_used)
+	SetInt(entry, "symtab_generation", typemap_search_symtab_generation);
+      Setattr(cache, key, entry);
+      Delete(entry);
+    }
+    typemap_search_symtab_used |= symtab_used;
+    if (matchtype)
+      *matchtype = mtype;
+    else
+      Delete(mtype);
+  }
+  Delete(key);
+  return result;
+}
+
 
 /* -----------------------------------------------------------------------------
  * typemap_search_multi()
@@ -1615,13 +1739,21 @@ static String *Swig_typemap_lookup_impl(const_String_or_char_ptr tmap_method, No
 }
 
 String *Swig_typemap_lookup_out(const_String_or_char_ptr tmap_method, Node *node, const_String_or_char_ptr lname, Wrapper *f, String *actioncode) {
+  String *s;
   assert(actioncode);
   assert(Cmp(tmap_method, "out") == 0);
-  return Swig_typemap_lookup_impl(tmap_method, node, lname, f, actioncode);
+  Swig_profile_begin("typemap:lookup");
+  s = Swig_typemap_lookup_impl(tmap_method, node, lname, f, actioncode);
+  Swig_profile_end("typemap:lookup");
+  return s;
 }
 
 String *Swig_typemap_lookup(const_String_or_char_ptr tmap_method, Node *node, const_String_or_char_ptr lname, Wrapper *f) {
-  return Swig_typemap_lookup_impl(tmap_method, node, lname, f, 0);
+  String *s;
+  Swig_profile_begin("typemap:lookup");
+  s = Swig_typemap_lookup_impl(tmap_method, node, lname, f, 0);
+  Swig_profile_end("typemap:lookup");
+  return s;
 }
 
 /* -----------------------------------------------------------------------------
@@ -1743,6 +1875,7 @@ void Swig_typemap_attach_parms(const_String_or_char_ptr tmap_method, ParmList *p
   String *kwmatch = 0;
   p = parms;
 
+  Swig_profile_begin("typemap:attach_parms");
 #ifdef SWIG_DEBUG
   Printf(stdout, "Swig_typemap_attach_parms:  %s\n", tmap_method);
 #endif
@@ -1913,7 +2046,7 @@ void Swig_typemap_attach_parms(const_String_or_char_ptr tmap_method, ParmList *p
 #ifdef SWIG_DEBUG
   Printf(stdout, "Swig_typemap_attach_parms: end\n");
 #endif
-
+  Swig_profile_end("typemap:attach_parms");
 }
 
 /* Splits the arguments of an embedded typemap */
@@ -2184,6 +2317,22 @@ void Swig_typemap_debug() {
 }
 
 
+/* -----------------------------------------------------------------------------
+ * Swig_typemap_search_cache_debug()
+ *
+ * Display typemap search cache statistics
+ * ----------------------------------------------------------------------------- */
+
+void Swig_typemap_search_cache_debug(void) {
+  int searches = typemap_search_cache_hits + typemap_search_cache_misses;
+  Printf(stdout, "---[ typemap search cache ]--------------------------------------------------\n");
+  Printf(stdout, "  Searches: %d\n", searches);
+  Printf(stdout, "  Hits:     %d (%.1f%%)\n", typemap_search_cache_hits, searches ? 100.0 * typemap_search_cache_hits / searches : 0.0);
+  Printf(stdout, "  Misses:   %d\n", typemap_search_cache_misses);
+  Printf(stdout, "  Flushes:  %d\n", typemap_search_cache_flushes);
+  Printf(stdout, "-----------------------------------------------------------------------------\n");
+}
+
 /* -----------------------------------------------------------------------------
  * Swig_typemap_search_debug_set()
  *
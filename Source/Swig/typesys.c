@@ -153,11 +153,41 @@ static Hash *current_symtab = 0;	/* Current symbol table
 static Typetab *global_scope = 0;	/* The global scope                             */
 static Hash *scopes = 0;	/* Hash table containing fully qualified scopes */
 
-/* Performance optimization */
+/* -----------------------------------------------------------------------------
+ * Typedef resolution caches
+ *
+ * SwigType_typedef_resolve(), SwigType_typedef_resolve_all() and
+ * SwigType_typedef_qualified() cache their results. The results depend on the
+ * scope the type is looked up in, so each scope has its own set of caches,
+ * kept in scope_caches keyed by the scope's address.  Changing scope just
+ * selects the caches of the new scope.  Other modules can keep their own
+ * results per scope with SwigType_scope_cache().
+ *
+ * A lookup made for the caches of a scope can read the type table of any scope
+ * that can be seen from it, including a scope named by a qualified name, and
+ * each scope read records the scope whose caches the result went into in
+ * cache_deps.  Adding a typedef to a scope therefore only discards the caches
+ * of that scope and of the scopes recorded as depending on it.  Adding a scope,
+ * a scope inheritance or an alias changes which scopes can be seen and
+ * discards the caches of all the scopes.
+ * ----------------------------------------------------------------------------- */
+
 #define SWIG_TYPEDEF_RESOLVE_CACHE 
+static Hash *scope_caches = 0;		/* Caches for each scope */
+static Hash *cache_deps = 0;		/* For each scope, the scopes whose caches have read its type table */
+static Hash *current_caches = 0;	/* Current scope's caches */
+static String *current_caches_key = 0;
 static Hash *typedef_resolve_cache = 0;
 static Hash *typedef_all_cache = 0;
 static Hash *typedef_qualified_cache = 0;
+static int typedef_resolve_calls = 0;
+static int typedef_resolve_hits = 0;
+static int typedef_all_calls = 0;
+static int typedef_all_hits = 0;
+static int typedef_qualified_calls = 0;
+static int typedef_qualified_hits = 0;
+static int typedef_cache_flushes = 0;
+static int typedef_cache_scope_flushes = 0;
 
 static Typetab *SwigType_find_scope(Typetab *s, const SwigType *nameprefix);
 
@@ -180,12 +210,121 @@ int Swig_value_wrapper_mode(int mode) {
 }
 
 
-static void flush_cache() {
+/* Deselect the caches after a change of the current scope */
+static void change_cache_scope() {
+  current_caches = 0;
+  Delete(current_caches_key);
+  current_caches_key = 0;
   typedef_resolve_cache = 0;
   typedef_all_cache = 0;
   typedef_qualified_cache = 0;
 }
 
+/* Discard the caches of all the scopes after a change to the scopes */
+static void flush_cache() {
+  if (scope_caches) {
+    Delete(scope_caches);
+    scope_caches = 0;
+    typedef_cache_flushes++;
+  }
+  Delete(cache_deps);
+  cache_deps = 0;
+  change_cache_scope();
+}
+
+/* Discard the caches depending on the type table of scope s after a change to it */
+static void flush_scope_cache(Typetab *s) {
+  String *key;
+  Hash *deps;
+  if (!scope_caches)
+    return;
+  key = NewStringf("%p", (void *) s);
+  Delattr(scope_caches, key);
+  deps = cache_deps ? Getattr(cache_deps, key) : 0;
+  if (deps) {
+    Iterator ki;
+    for (ki = First(deps); ki.key; ki = Next(ki)) {
+      Delattr(scope_caches, ki.key);
+    }
+    Delattr(cache_deps, key);
+  }
+  Delete(key);
+  typedef_cache_scope_flushes++;
+  change_cache_scope();
+}
+
+/* Record that the current scope's caches depend on the type table of scope s */
+static void cache_depend(Typetab *s) {
+  String *key;
+  Hash *deps;
+  if (!current_caches || s == current_scope)
+    return;
+  if (!cache_deps)
+    cache_deps = NewHash();
+  key = NewStringf("%p", (void *) s);
+  deps = Getattr(cache_deps, key);
+  if (!deps) {
+    deps = NewHash();
+    Setattr(cache_deps, key, deps);
+    Delete(deps);
+  }
+  if (!Getattr(deps, current_caches_key))
+    Setattr(deps, current_caches_key, "1");
+  Delete(key);
+}
+
+/* Select the caches for the current scope, creating them if necessary */
+static void select_cache_scope() {
+  Hash *caches;
+  String *key;
+  if (current_caches)
+    return;
+  if (!scope_caches)
+    scope_caches = NewHash();
+  key = NewStringf("%p", (void *) current_scope);
+  caches = Getattr(scope_caches, key);
+  if (!caches) {
+    Hash *h;
+    caches = NewHash();
+    h = NewHash();
+    Setattr(caches, "resolve", h);
+    Delete(h);
+    h = NewHash();
+    Setattr(caches, "all", h);
+    Delete(h);
+    h = NewHash();
+    Setattr(caches, "qualified", h);
+    Delete(h);
+    Setattr(scope_caches, key, caches);
+    Delete(caches);
+  }
+  current_caches = caches;
+  current_caches_key = key;
+  typedef_resolve_cache = Getattr(caches, "resolve");
+  typedef_all_cache = Getattr(caches, "all");
+  typedef_qualified_cache = Getattr(caches, "qualified");
+}
+
+/* -----------------------------------------------------------------------------
+ * SwigType_scope_cache()
+ *
+ * Returns the cache called name of the current scope, for results depending on
+ * the typedefs visible from the current scope.  The cache is discarded with the
+ * typedef resolution caches of the scope.
+ * ----------------------------------------------------------------------------- */
+
+Hash *SwigType_scope_cache(const_String_or_char_ptr name) {
+  Hash *cache;
+  select_cache_scope();
+  cache = Getattr(current_caches, name);
+  if (!cache) {
+    cache = NewHash();
+    Setattr(current_caches, name, cache);
+    Delete(cache);
+  }
+  return cache;
+}
+
 /* Initialize the scoping system */
 
 void SwigType_typesystem_init() {
@@ -193,6 +332,7 @@ void SwigType_typesystem_init() {
     Delete(global_scope);
   if (scopes)
     Delete(scopes);
+  flush_cache();
 
   current_scope = NewHash();
   global_scope = current_scope;
@@ -234,7 +374,7 @@ int SwigType_typedef(const SwigType *type, const_String_or_char_ptr name) {
     }
   }
   Setattr(current_typetab, name, type);
-  flush_cache();
+  flush_scope_cache(current_scope);
   return 0;
 }
 
@@ -254,7 +394,7 @@ int SwigType_typedef_class(const_String_or_char_ptr name) {
   Setmeta(cname, "class", "1");
   Setattr(current_typetab, cname, cname);
   Delete(cname);
-  flush_cache();
+  flush_scope_cache(current_scope);
   return 0;
 }
 
@@ -351,6 +491,7 @@ void SwigType_inherit_scope(Typetab *scope) {
       return;
   }
   Append(inherits, scope);
+  flush_cache();
 }
 
 /* -----------------------------------------------------------------------------
@@ -415,7 +556,7 @@ Typetab *SwigType_pop_scope() {
   current_scope = t;
   current_typetab = Getattr(t, "typetab");
   current_symtab = Getattr(t, "symtab");
-  flush_cache();
+  change_cache_scope();
   return old;
 }
 
@@ -432,7 +573,7 @@ Typetab *SwigType_set_scope(Typetab *t) {
   current_scope = t;
   current_typetab = Getattr(t, "typetab");
   current_symtab = Getattr(t, "symtab");
-  flush_cache();
+  change_cache_scope();
   return old;
 }
 
@@ -445,6 +586,7 @@ Typetab *SwigType_set_scope(Typetab *t) {
 void SwigType_attach_symtab(Symtab *sym) {
   Setattr(current_scope, "symtab", sym);
   current_symtab = sym;
+  flush_cache();
 }
 
 /* -----------------------------------------------------------------------------
@@ -479,6 +621,25 @@ void SwigType_print_scope(void) {
   Printf(stdout, "SCOPES finish =======================================\n");
 }
 
+/* -----------------------------------------------------------------------------
+ * SwigType_typedef_cache_debug()
+ *
+ * Display typedef resolution cache statistics
+ * ----------------------------------------------------------------------------- */
+
+static void typedef_cache_debug_line(const char *name, int calls, int hits) {
+  Printf(stdout, "  %-27s %8d calls %8d hits (%.1f%%)\n", name, calls, hits, calls ? 100.0 * hits / calls : 0.0);
+}
+
+void SwigType_typedef_cache_debug(void) {
+  Printf(stdout, "---[ typedef resolution cache ]----------------------------------------------\n");
+  typedef_cache_debug_line("SwigType_typedef_resolve", typedef_resolve_calls, typedef_resolve_hits);
+  typedef_cache_debug_line("SwigType_typedef_resolve_all", typedef_all_calls, typedef_all_hits);
+  typedef_cache_debug_line("SwigType_typedef_qualified", typedef_qualified_calls, typedef_qualified_hits);
+  Printf(stdout, "  Flushes:  %d (all scopes), %d (one scope and its dependents)\n", typedef_cache_flushes, typedef_cache_scope_flushes);
+  Printf(stdout, "-----------------------------------------------------------------------------\n");
+}
+
 static Typetab *SwigType_find_scope(Typetab *s, const SwigType *nameprefix) {
   Typetab *ss;
   Typetab *s_orig = s;
@@ -578,6 +739,7 @@ static SwigType *_typedef_resolve(Typetab *s, String *base, int look_parent) {
 
     ttab = Getattr(s, "typetab");
     type = Getattr(ttab, base);
+    cache_depend(s);
     if (type) {
       resolved_scope = s;
       Setmark(s, 0);
@@ -693,13 +855,14 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
   resolved_scope = 0;
 
 #ifdef SWIG_TYPEDEF_RESOLVE_CACHE
-  if (!typedef_resolve_cache) {
-    typedef_resolve_cache = NewHash();
-  }
+  typedef_resolve_calls++;
+  select_cache_scope();
   r = Getattr(typedef_resolve_cache, t);
   if (r) {
+    typedef_resolve_hits++;
     resolved_scope = Getmeta(r, "scope");
-    return Copy(r);
+    /* An empty type caches a failed lookup */
+    return Len(r) ? Copy(r) : 0;
   }
 #endif
 
@@ -720,6 +883,7 @@ SwigType *SwigType_typedef_resolve(const SwigType *t) {
     }
     /* Do a quick check in the local scope */
     type = Getattr(ttab, base);
+    cache_depend(s);
     if (type) {
       resolved_scope = s;
     }
@@ -986,6 +1150,11 @@ return_result:
       r1 = Copy(r);
       Delete(r);
       r = r1;
+    } else {
+      String *unresolved = NewStringEmpty();
+      Setmeta(unresolved, "scope", resolved_scope);
+      Setattr(typedef_resolve_cache, key, unresolved);
+      Delete(unresolved);
     }
     Delete(key);
   }
@@ -1005,11 +1174,11 @@ SwigType *SwigType_typedef_resolve_all(const SwigType *t) {
   int count = 0;
 
   /* Check to see if the typedef resolve has been done before by checking the cache */
-  if (!typedef_all_cache) {
-    typedef_all_cache = NewHash();
-  }
+  typedef_all_calls++;
+  select_cache_scope();
   r = Getattr(typedef_all_cache, t);
   if (r) {
+    typedef_all_hits++;
     return Copy(r);
   }
 
@@ -1066,11 +1235,12 @@ SwigType *SwigType_typedef_qualified(const SwigType *t) {
   String *result;
   int i, len;
 
-  if (!typedef_qualified_cache)
-    typedef_qualified_cache = NewHash();
+  typedef_qualified_calls++;
+  select_cache_scope();
   result = Getattr(typedef_qualified_cache, t);
   if (result) {
     String *rc = Copy(result);
+    typedef_qualified_hits++;
     return rc;
   }
 
@@ -1303,6 +1473,7 @@ int SwigType_typedef_using(const_String_or_char_ptr name) {
 
   /* We set up a typedef  B --> A::B */
   Setattr(current_typetab, base, name);
+  flush_scope_cache(current_scope);
 
   /* Find the scope name where the symbol is defined */
   td = SwigType_typedef_resolve(name);
@@ -2222,7 +2393,7 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
     }
     Delete(nthash);
 
-    Printf(types, "\"%s\", \"%s\", 0, 0, (void*)%s, 0};\n", ki.item, nt, cd);
+    Printf(types, "\"%s\", \"%s\", 0, 0, (void*)%s, 0, 0, 0};\n", ki.item, nt, cd);
 
     el = SwigType_equivalent_mangle(ki.item, 0, 0);
     for (ei = First(el); ei.item; ei = Next(ei)) {
@@ -2238,7 +2409,7 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
       Delete(ckey);
 
       if (!Getattr(r_mangled, ei.item) && !Getattr(imported_types, ei.item)) {
-	Printf(types, "static swig_type_info _swigt_%s = {\"%s\", 0, 0, 0, 0, 0};\n", ei.item, ei.item);
+	Printf(types, "static swig_type_info _swigt_%s = {\"%s\", 0, 0, 0, 0, 0, 0, 0};\n", ei.item, ei.item);
 	Append(table_list, ei.item);
 
 	Printf(cast, "static swig_cast_info _swigc_%s[] = {{&_swigt_%s, 0, 0, 0},{0, 0, 0, 0}};\n", ei.item, ei.item);
@@ -2280,7 +2451,7 @@ void SwigType_emit_type_table(File *f_forward, File *f_table) {
   Printf(f_table, "\n/* -------- TYPE CONVERSION AND EQUIVALENCE RULES (END) -------- */\n\n");
 
   Printf(f_forward, "static swig_type_info *swig_types[%d];\n", i + 1);
-  Printf(f_forward, "static swig_module_info swig_module = {swig_types, %d, 0, 0, 0, 0};\n", i);
+  Printf(f_forward, "static swig_module_info swig_module = {swig_types, %d, 0, 0, 0, 0, 0};\n", i);
   Printf(f_forward, "#define SWIG_TypeQuery(name) SWIG_TypeQueryModule(&swig_module, &swig_module, name)\n");
   Printf(f_forward, "#define SWIG_MangledTypeQuery(name) SWIG_MangledTypeQueryModule(&swig_module, &swig_module, name)\n");
   Printf(f_forward, "\n/* -------- TYPES TABLE (END) -------- */\n\n");
@@ -0,0 +1,196 @@
+#!/usr/bin/env python
+
+"""
+Run the test-suite for a target language in parallel and record how long each
+testcase spends running SWIG, compiling and running the runtime test.
+
+Run from the top of the build directory, for example:
+
+  Tools/test-suite-timing.py -j8 -o timing.json python PY3=1
+  Tools/test-suite-timing.py -j8 -o new.json --baseline old.json java
+
+The testcases are shared out between the jobs, each testcase being run with
+'make -s [testcase].cpptest' etc in Examples/test-suite/[lang].  The time spent
+in SWIG and in the runtime test are measured by running them under this script
+using the SWIGTOOL and RUNTOOL make variables. The remaining time of the
+testcase, which is mostly spent compiling and linking, is the compile time.
+
+The timings are written to a JSON report. When a baseline report from an
+earlier run is given, testcases for which SWIG has got slower are listed, so
+that performance regressions in SWIG itself can be spotted.
+"""
+
+from __future__ import print_function
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import threading
+import time
+
+TIMING_LOG = "SWIG_TEST_TIMING_LOG"
+
+
+def timed_command(phase, command):
+    """Run command and append its elapsed time to the file in TIMING_LOG."""
+    start = time.time()
+    ret = subprocess.call(command)
+    elapsed = time.time() - start
+    log = os.environ.get(TIMING_LOG)
+    if log:
+        with open(log, "a") as f:
+            f.write("%s %f\n" % (phase, elapsed))
+    return ret
+
+
+def make_command(args, extra):
+    return ["make", "-s", "--no-print-directory", "-C", args.directory] + extra
+
+
+def list_testcases(args):
+    output = subprocess.check_output(make_command(args, args.make_args + ["check-list"]))
+    return output.decode().split()
+
+
+def run_testcase(args, testcase, logdir):
+    """Run a single testcase, returning its timings."""
+    log = os.path.join(logdir, testcase + ".timing")
+    output = os.path.join(logdir, testcase + ".log")
+    if os.path.exists(log):
+        os.remove(log)
+    wrapper = "%s %s --phase" % (sys.executable, os.path.abspath(__file__))
+    env = dict(os.environ)
+    env[TIMING_LOG] = log
+    tools = ["SWIGTOOL=%s swig" % wrapper]
+    if args.partial:
+        tools += ["CC=true", "CXX=true", "LDSHARED=true", "CXXSHARED=true", "RUNTOOL=true", "COMPILETOOL=true"]
+    else:
+        tools += ["RUNTOOL=%s run" % wrapper]
+    start = time.time()
+    with open(output, "w") as f:
+        ret = subprocess.call(make_command(args, args.make_args + tools + [testcase]),
+                              stdout=f, stderr=subprocess.STDOUT, env=env)
+    total = time.time() - start
+    result = {"status": "passed" if ret == 0 else "failed", "swig": 0.0, "compile": 0.0, "run": 0.0, "total": total}
+    if os.path.exists(log):
+        with open(log) as f:
+            for line in f:
+                phase, elapsed = line.split()
+                result[phase] += float(elapsed)
+        os.remove(log)
+    result["compile"] = max(0.0, total - result["swig"] - result["run"])
+    if ret == 0:
+        os.remove(output)
+    else:
+        result["log"] = output
+    return result
+
+
+def run_testcases(args, testcases, logdir):
+    results = {}
+    pending = list(testcases)
+    lock = threading.Lock()
+
+    def worker():
+        while True:
+            with lock:
+                if not pending:
+                    return
+                testcase = pending.pop(0)
+            result = run_testcase(args, testcase, logdir)
+            with lock:
+                results[testcase] = result
+                if result["status"] != "passed" or args.verbose:
+                    print("%s %s (swig %.2fs, compile %.2fs, run %.2fs)" %
+                          (result["status"], testcase, result["swig"], result["compile"], result["run"]))
+                    sys.stdout.flush()
+
+    threads = [threading.Thread(target=worker) for i in range(max(1, args.jobs))]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return results
+
+
+def compare(report, baseline, threshold, min_delta):
+    """Return the testcases for which SWIG is slower than in the baseline."""
+    regressions = []
+    old_tests = baseline.get("tests", {})
+    for testcase, result in sorted(report["tests"].items()):
+        old = old_tests.get(testcase)
+        if not old or result["status"] != "passed" or old["status"] != "passed":
+            continue
+        delta = result["swig"] - old["swig"]
+        if delta > min_delta and result["swig"] > old["swig"] * (1.0 + threshold / 100.0):
+            regressions.append((testcase, old["swig"], result["swig"]))
+    return regressions
+
+
+def main():
+    if len(sys.argv) > 2 and sys.argv[1] == "--phase":
+        return timed_command(sys.argv[2], sys.argv[3:])
+
+    parser = argparse.ArgumentParser(description="Run the SWIG test-suite for a target language in parallel, recording per testcase timings.")
+    parser.add_argument("language", help="target language, for example python, java or fortran")
+    parser.add_argument("make_args", nargs="*", help="extra make variables, for example PY3=1")
+    parser.add_argument("-j", "--jobs", type=int, default=1, help="number of testcases to run in parallel")
+    parser.add_argument("-o", "--output", default="test-suite-timing.json", help="JSON report to write")
+    parser.add_argument("-b", "--baseline", help="JSON report from an earlier run to compare the SWIG times against")
+    parser.add_argument("--threshold", type=float, default=20.0, help="percentage by which the SWIG time must increase to be reported as a regression")
+    parser.add_argument("--min-delta", type=float, default=0.05, help="seconds by which the SWIG time must increase to be reported as a regression")
+    parser.add_argument("-t", "--tests", nargs="+", help="testcases to run, for example bools.cpptest, instead of all those run by 'make check'")
+    parser.add_argument("--partial", action="store_true", help="only run SWIG, as for 'make partialcheck'")
+    parser.add_argument("-v", "--verbose", action="store_true", help="display the timings of every testcase")
+    args = parser.parse_args()
+    args.directory = os.path.join("Examples", "test-suite", args.language)
+
+    if not os.path.isdir(args.directory):
+        print("No test-suite directory %s, run from the top of the build directory" % args.directory, file=sys.stderr)
+        return 2
+
+    testcases = args.tests if args.tests else list_testcases(args)
+    logdir = os.path.abspath(os.path.join(args.directory, "timing-logs"))
+    if not os.path.isdir(logdir):
+        os.makedirs(logdir)
+
+    start = time.time()
+    results = run_testcases(args, testcases, logdir)
+    report = {
+        "language": args.language,
+        "jobs": args.jobs,
+        "partial": args.partial,
+        "total": time.time() - start,
+        "tests": results,
+    }
+    with open(args.output, "w") as f:
+        json.dump(report, f, indent=2, sort_keys=True)
+
+    failed = sorted(t for t, r in results.items() if r["status"] != "passed")
+    passed = len(results) - len(failed)
+    swig_time = sum(r["swig"] for r in results.values())
+    compile_time = sum(r["compile"] for r in results.values())
+    run_time = sum(r["run"] for r in results.values())
+    print("%d %s tests passed, %d failed in %.1fs (swig %.1fs, compile %.1fs, run %.1fs)" %
+          (passed, args.language, len(failed), report["total"], swig_time, compile_time, run_time))
+    for testcase in failed:
+        print("  failed: %s, see %s" % (testcase, results[testcase]["log"]))
+
+    status = 1 if failed else 0
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+        old_swig_time = sum(r["swig"] for t, r in baseline.get("tests", {}).items() if t in results)
+        print("SWIG time %.1fs, baseline %.1fs" % (swig_time, old_swig_time))
+        regressions = compare(report, baseline, args.threshold, args.min_delta)
+        for testcase, old, new in regressions:
+            print("  slower: %s swig %.2fs -> %.2fs (+%.0f%%)" % (testcase, old, new, 100.0 * (new - old) / old if old else 0.0))
+        if regressions:
+            status = 1
+    return status
+
+
+if __name__ == "__main__":
+    sys.exit(main())